@@ -0,0 +1,113 @@
+#include "CppUnitTest.h"
+#include "snct_adaptive_order.hpp"
+#include "snct_constraints.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	using Adaptive = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<1000>, snct::MultipleOf<4>>;
+	using Reference = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<1000>, snct::MultipleOf<4>, snct::AlwaysSatisfied>;
+	using Pinned = snct::Constrained<int, snct::GreaterThan<0>, snct::LessThan<10>>;
+	using Interleaved_A = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<1000>>;
+	using Interleaved_B = snct::Constrained<int, snct::Minimum<1>, snct::Maximum<100>>;
+
+	void validate(int value, int times)
+	{
+		for (int i = 0; i < times; ++i)
+			(void)Adaptive::factory(value);
+	}
+}
+
+namespace snct
+{
+	template<>
+	inline constexpr bool adapts_constraint_order<Adaptive> = true;
+	template<>
+	inline constexpr bool adapts_constraint_order<Pinned> = true;
+	template<>
+	inline constexpr bool adapts_constraint_order<Interleaved_A> = true;
+	template<>
+	inline constexpr bool adapts_constraint_order<Interleaved_B> = true;
+}
+
+namespace adaptive_order
+{
+	TEST_CLASS(constraint_order)
+	{
+		TEST_METHOD(starts_in_declaration_order)
+		{
+			Assert::IsTrue(snct::constraint_order<Pinned>() == std::array<std::size_t, 2>{ 0, 1 });
+		}
+
+		TEST_METHOD(moves_the_most_rejecting_constraint_first)
+		{
+			snct::unpin_constraint_order<Adaptive>();
+			validate(501, 64 * 256);
+			Assert::AreEqual(std::size_t{ 2 }, snct::constraint_order<Adaptive>()[0]);
+
+			// Once values mostly break the upper bound instead, it takes over after a few reselections
+			validate(2000, 64 * 256 * 4);
+			Assert::AreEqual(std::size_t{ 1 }, snct::constraint_order<Adaptive>()[0]);
+		}
+
+		TEST_METHOD(does_not_change_which_values_are_accepted)
+		{
+			snct::unpin_constraint_order<Adaptive>();
+			validate(7, 64 * 256);
+			for (int value = -100; value < 1100; ++value)
+				Assert::AreEqual(Reference::satisfies_constraints(value), Adaptive::satisfies_constraints(value));
+		}
+
+		TEST_METHOD(samples_each_alias_when_validations_alternate)
+		{
+			// With one sample counter for all aliases, every sample would land on the same one of the two
+			for (int i = 0; i < 64 * 256; ++i)
+			{
+				(void)Interleaved_A::factory(2000);
+				(void)Interleaved_B::factory(500);
+			}
+			Assert::AreEqual(std::size_t{ 1 }, snct::constraint_order<Interleaved_A>()[0]);
+			Assert::AreEqual(std::size_t{ 1 }, snct::constraint_order<Interleaved_B>()[0]);
+		}
+
+		TEST_METHOD(constructor_still_reports_the_first_declared_violation)
+		{
+			snct::unpin_constraint_order<Adaptive>();
+			validate(501, 64 * 256);
+			try {
+				Adaptive{ -3 };
+			}
+			catch (snct::Constraint_Exception const& e) {
+				Assert::AreEqual(std::string{ snct::Minimum<0>::error_message() }, std::string{ e.error_message() });
+				return;
+			}
+			Assert::Fail();
+		}
+	};
+
+	TEST_CLASS(pin_constraint_order)
+	{
+		TEST_METHOD(fixes_the_order)
+		{
+			Assert::IsTrue(snct::pin_constraint_order<Pinned>(std::array<std::size_t, 2>{ 1, 0 }));
+			for (int i = 0; i < 64 * 256 * 2; ++i)
+				(void)Pinned::factory(0);
+			snct::reselect_constraint_order<Pinned>();
+			Assert::IsTrue(snct::constraint_order<Pinned>() == std::array<std::size_t, 2>{ 1, 0 });
+
+			snct::unpin_constraint_order<Pinned>();
+			snct::reselect_constraint_order<Pinned>();
+			Assert::IsTrue(snct::constraint_order<Pinned>() == std::array<std::size_t, 2>{ 0, 1 });
+		}
+
+		TEST_METHOD(rejects_orders_that_are_not_permutations)
+		{
+			Assert::IsFalse(snct::pin_constraint_order<Adaptive>(std::array<std::size_t, 3>{ 0, 0, 1 }));
+			Assert::IsFalse(snct::pin_constraint_order<Adaptive>(std::array<std::size_t, 3>{ 0, 1, 3 }));
+		}
+	};
+}
@@ -0,0 +1,173 @@
+#include "CppUnitTest.h"
+#include "snct_atomic.hpp"
+#include "snct_constraints.hpp"
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	using Percent = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<100>>;
+	using Atomic_Percent = snct::AtomicConstrained<int, snct::Minimum<0>, snct::Maximum<100>>;
+	using Atomic_Even = snct::AtomicConstrained<int, snct::MultipleOf<2>>;
+	using Atomic_Count = snct::AtomicConstrained<std::uint8_t, snct::Maximum<std::uint8_t{ 250 }>>;
+	using Atomic_Ratio = snct::AtomicConstrained<double, snct::Minimum<0.0>, snct::Maximum<1.0>>;
+
+	template<typename F>
+	bool throws_constraint_exception(F f)
+	{
+		try {
+			f();
+		}
+		catch (snct::Constraint_Exception const&) {
+			return true;
+		}
+		return false;
+	}
+}
+
+namespace atomic
+{
+	TEST_CLASS(load_and_store)
+	{
+		TEST_METHOD(is_lock_free_like_the_underlying_atomic)
+		{
+			static_assert(Atomic_Percent::is_always_lock_free == std::atomic<int>::is_always_lock_free);
+			auto const a = Atomic_Percent{ 1 };
+			Assert::AreEqual(std::atomic<int>{}.is_lock_free(), a.is_lock_free());
+		}
+
+		TEST_METHOD(initial_value_is_checked)
+		{
+			Assert::IsTrue(throws_constraint_exception([] { Atomic_Percent a{ 101 }; }));
+		}
+
+		TEST_METHOD(loads_what_was_stored)
+		{
+			auto a = Atomic_Percent{ 10 };
+			Assert::AreEqual(10, a.load().get());
+			a.store(Percent{ 90 });
+			Assert::AreEqual(90, a.load().get());
+			a.store(70);
+			Assert::AreEqual(70, static_cast<Percent>(a).get());
+		}
+
+		TEST_METHOD(storing_a_rejected_value_throws_and_changes_nothing)
+		{
+			auto a = Atomic_Percent{ 10 };
+			Assert::IsTrue(throws_constraint_exception([&] { a.store(-1); }));
+			Assert::AreEqual(10, a.load().get());
+		}
+
+		TEST_METHOD(exchange_returns_the_previous_value)
+		{
+			auto a = Atomic_Percent{ 10 };
+			Assert::AreEqual(10, a.exchange(20).get());
+			Assert::AreEqual(20, a.load().get());
+		}
+	};
+
+	TEST_CLASS(compare_exchange)
+	{
+		TEST_METHOD(replaces_the_expected_value)
+		{
+			auto a = Atomic_Percent{ 10 };
+			auto expected = Percent{ 10 };
+			Assert::IsTrue(a.compare_exchange_strong(expected, 20));
+			Assert::AreEqual(20, a.load().get());
+		}
+
+		TEST_METHOD(reports_the_current_value_on_failure)
+		{
+			auto a = Atomic_Percent{ 10 };
+			auto expected = Percent{ 50 };
+			Assert::IsFalse(a.compare_exchange_strong(expected, 20));
+			Assert::AreEqual(10, expected.get());
+			Assert::AreEqual(10, a.load().get());
+		}
+
+		TEST_METHOD(weak_succeeds_in_a_loop)
+		{
+			auto a = Atomic_Percent{ 10 };
+			auto expected = a.load();
+			while (!a.compare_exchange_weak(expected, Percent{ expected.get() + 5 }))
+				;
+			Assert::AreEqual(15, a.load().get());
+		}
+	};
+
+	TEST_CLASS(fetch_add)
+	{
+		TEST_METHOD(returns_the_previous_value)
+		{
+			auto a = Atomic_Percent{ 10 };
+			Assert::AreEqual(10, a.fetch_add(5).get());
+			Assert::AreEqual(15, a.fetch_sub(3).get());
+			Assert::AreEqual(12, a.load().get());
+		}
+
+		TEST_METHOD(throws_and_changes_nothing_when_the_result_is_rejected)
+		{
+			auto a = Atomic_Percent{ 95 };
+			Assert::IsTrue(throws_constraint_exception([&] { (void)a.fetch_add(10); }));
+			Assert::IsTrue(throws_constraint_exception([&] { (void)a.fetch_sub(96); }));
+			Assert::AreEqual(95, a.load().get());
+
+			auto even = Atomic_Even{ 4 };
+			Assert::IsTrue(throws_constraint_exception([&] { (void)even.fetch_add(1); }));
+			Assert::AreEqual(6, even.fetch_add(2).get() + 2);
+		}
+
+		TEST_METHOD(try_returns_nullopt_when_the_result_is_rejected)
+		{
+			auto a = Atomic_Percent{ 95 };
+			Assert::IsFalse(a.try_fetch_add(10).has_value());
+			Assert::IsFalse(a.try_fetch_sub(-10).has_value());
+			Assert::AreEqual(95, a.try_fetch_add(5)->get());
+			Assert::AreEqual(100, a.load().get());
+		}
+
+		TEST_METHOD(overflow_is_rejected_rather_than_wrapped)
+		{
+			auto count = Atomic_Count{ std::uint8_t{ 200 } };
+			Assert::IsFalse(count.try_fetch_add(std::uint8_t{ 100 }).has_value());
+			Assert::IsFalse(count.try_fetch_sub(std::uint8_t{ 201 }).has_value());
+			Assert::AreEqual(200, static_cast<int>(count.load().get()));
+
+			auto big = snct::AtomicConstrained<int, snct::Maximum<INT_MAX>>{ INT_MAX - 1 };
+			Assert::IsTrue(throws_constraint_exception([&] { (void)big.fetch_add(2); }));
+			Assert::AreEqual(INT_MAX - 1, big.fetch_add(1).get());
+		}
+
+		TEST_METHOD(works_for_floating_point)
+		{
+			auto r = Atomic_Ratio{ 0.5 };
+			Assert::AreEqual(0.5, r.fetch_add(0.25).get());
+			Assert::IsFalse(r.try_fetch_add(0.5).has_value());
+			Assert::AreEqual(0.75, r.load().get());
+		}
+
+		TEST_METHOD(concurrent_increments_stop_at_the_bound)
+		{
+			auto a = Atomic_Percent{ 0 };
+			std::atomic<int> accepted{ 0 };
+
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+				threads.emplace_back([&] {
+					for (int i = 0; i < 100; ++i)
+						if (a.try_fetch_add(1))
+							accepted.fetch_add(1);
+				});
+			for (auto& thread : threads)
+				thread.join();
+
+			Assert::AreEqual(100, a.load().get());
+			Assert::AreEqual(100, accepted.load());
+		}
+	};
+}
@@ -0,0 +1,85 @@
+#include "CppUnitTest.h"
+#include "snct_batch.hpp"
+#include "snct_constraints.hpp"
+#include "test_doubles.h"
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace batch::partition_valid
+{
+	using Divisor = snct::Constrained<double, snct::Not<0.0>, snct::Finite>;
+	using Small = snct::Constrained<int, snct::Minimum<0>, snct::LessThan<10>>;
+
+	TEST_CLASS(splits_values)
+	{
+		TEST_METHOD(into_valid_and_invalid_preserving_order)
+		{
+			// Arrange
+			auto const in = std::vector<int>{ 3, -1, 9, 10, 0, 42, 5 };
+			auto valid = std::vector<int>(in.size());
+			auto invalid = std::vector<int>(in.size());
+
+			// Act
+			auto const counts = snct::partition_valid<Small>(in, valid, invalid);
+
+			// Assert
+			Assert::AreEqual(std::size_t{ 4 }, counts.valid);
+			Assert::AreEqual(std::size_t{ 3 }, counts.invalid);
+			Assert::IsTrue(std::vector<int>{ 3, 9, 0, 5 } == std::vector<int>(valid.begin(), valid.begin() + counts.valid));
+			Assert::IsTrue(std::vector<int>{ -1, 10, 42 } == std::vector<int>(invalid.begin(), invalid.begin() + counts.invalid));
+		}
+
+		TEST_METHOD(longer_than_one_vector_register)
+		{
+			// Arrange
+			auto in = std::vector<double>{};
+			for (int i = 0; i < 37; ++i)
+				in.push_back(i % 3 == 0 ? 0.0 : i);
+			in.push_back(Doubles.at(DD::quiet_NaN));
+			in.push_back(Doubles.at(DD::positive_infinity));
+			auto valid = std::vector<double>(in.size());
+			auto invalid = std::vector<double>(in.size());
+
+			// Act
+			auto const counts = snct::partition_valid<Divisor>(in, valid, invalid);
+
+			// Assert
+			Assert::AreEqual(std::size_t{ 24 }, counts.valid);
+			Assert::AreEqual(std::size_t{ 15 }, counts.invalid);
+			for (std::size_t i = 0; i < counts.valid; ++i)
+				Assert::IsTrue(Divisor::satisfies_constraints(valid[i]));
+			for (std::size_t i = 0; i < counts.invalid; ++i)
+				Assert::IsFalse(Divisor::satisfies_constraints(invalid[i]));
+		}
+
+		TEST_METHOD(only_as_far_as_the_outputs_have_room)
+		{
+			// Arrange
+			auto const in = std::vector<int>{ 1, 2, 3, 4, 5 };
+			auto valid = std::vector<int>(5);
+			auto invalid = std::vector<int>(2);
+
+			// Act
+			auto const counts = snct::partition_valid<Small>(in, valid, invalid);
+
+			// Assert
+			Assert::AreEqual(std::size_t{ 2 }, counts.valid + counts.invalid);
+		}
+	};
+
+	TEST_CLASS(is_constexpr)
+	{
+		TEST_METHOD(when_evaluated_at_compile_time)
+		{
+			constexpr auto counts = [] {
+				int in[] = { 1, 20, 3 };
+				int valid[3] = {};
+				int invalid[3] = {};
+				return snct::partition_valid<Small>(in, valid, invalid);
+			}();
+
+			static_assert(counts.valid == 2 && counts.invalid == 1);
+		}
+	};
+}
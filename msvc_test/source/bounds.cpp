@@ -0,0 +1,111 @@
+#include "CppUnitTest.h"
+#include "snct_bounds.hpp"
+#include <cstdint>
+#include <limits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace bounds
+{
+	using Probability = snct::Constrained<double, snct::Minimum<0.0>, snct::Maximum<1.0>>;
+	using Positive = snct::Constrained<double, snct::GreaterThan<0.0>>;
+	using Unit = snct::Constrained<float, snct::Minimum<0.0f>, snct::LessThan<1.0f>>;
+	using Measurement = snct::Constrained<double, snct::NotNaN>;
+	using Percent = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<100>>;
+	using Byte = snct::Constrained<std::uint8_t, snct::Not<std::uint8_t{ 0 }>>;
+	using Letter = snct::Constrained<char, snct::Minimum<'a'>, snct::Maximum<'z'>>;
+
+	TEST_CLASS(bounds_of)
+	{
+		TEST_METHOD(reads_floating_point_bounds)
+		{
+			constexpr auto b = snct::bounds_of<Probability>;
+			static_assert(b.lower == 0.0 && b.upper == 1.0);
+			static_assert(b.lower_bounded && b.upper_bounded);
+			static_assert(!b.may_be_nan);
+		}
+
+		TEST_METHOD(makes_strict_bounds_inclusive)
+		{
+			static_assert(snct::bounds_of<Positive>.lower == std::numeric_limits<double>::denorm_min());
+			static_assert(snct::bounds_of<Unit>.upper < 1.0f);
+			static_assert(snct::bounds_of<Unit>.upper == snct::next_down(1.0f));
+
+			using Wide = snct::Constrained<long double, snct::GreaterThan<0.0L>, snct::LessThan<1.0L>>;
+			static_assert(snct::bounds_of<Wide>.lower == std::numeric_limits<long double>::denorm_min());
+			static_assert(snct::bounds_of<Wide>.upper == snct::next_down(1.0L));
+			static_assert(std::numeric_limits<Wide>::max() < 1.0L);
+		}
+
+		TEST_METHOD(reports_open_ends)
+		{
+			constexpr auto b = snct::bounds_of<Positive>;
+			static_assert(!b.upper_bounded);
+			static_assert(b.upper == std::numeric_limits<double>::infinity());
+			static_assert(!b.may_be_nan);
+		}
+
+		TEST_METHOD(reports_nan)
+		{
+			static_assert(snct::bounds_of<snct::Constrained<double, snct::AlwaysSatisfied>>.may_be_nan);
+			static_assert(!snct::bounds_of<Measurement>.may_be_nan);
+			static_assert(!snct::bounds_of<Measurement>.lower_bounded);
+		}
+
+		TEST_METHOD(reads_integer_bounds)
+		{
+			static_assert(snct::bounds_of<Percent>.lower == 0 && snct::bounds_of<Percent>.upper == 100);
+			static_assert(snct::bounds_of<Letter>.lower == 'a' && snct::bounds_of<Letter>.upper == 'z');
+			static_assert(!snct::bounds_of<Byte>.lower_bounded && !snct::bounds_of<Byte>.upper_bounded);
+		}
+
+		TEST_METHOD(converts_bounds_of_the_other_kind)
+		{
+			// The integer bounds truncate the value they check, so -0.5 and 10.5 pass
+			using Scale = snct::Constrained<double, snct::Minimum<0>, snct::Maximum<10>>;
+			static_assert(snct::bounds_of<Scale>.lower == snct::next_up(-1.0) && snct::bounds_of<Scale>.upper == snct::next_down(11.0));
+			static_assert(snct::bounds_of<Scale>.lower_bounded && snct::bounds_of<Scale>.upper_bounded);
+			static_assert(std::numeric_limits<Scale>::max() == snct::next_down(11.0));
+			Assert::IsTrue(Scale::satisfies_constraints(snct::bounds_of<Scale>.lower));
+			Assert::IsFalse(Scale::satisfies_constraints(snct::next_down(snct::bounds_of<Scale>.lower)));
+			Assert::IsTrue(Scale::satisfies_constraints(snct::bounds_of<Scale>.upper));
+			Assert::IsFalse(Scale::satisfies_constraints(snct::next_up(snct::bounds_of<Scale>.upper)));
+
+			static_assert(snct::bounds_of<snct::Constrained<float, snct::GreaterThan<0>>>.lower == 1.0f);
+			static_assert(snct::bounds_of<snct::Constrained<float, snct::LessThan<0>>>.upper == -1.0f);
+
+			using Rounded = snct::Constrained<int, snct::Minimum<2.5>, snct::LessThan<7.5>>;
+			static_assert(snct::bounds_of<Rounded>.lower == 3 && snct::bounds_of<Rounded>.upper == 7);
+
+			// Beyond 2^53 the integers around the bound have no exact double, so the bound is ignored
+			using Huge = snct::Constrained<double, snct::Maximum<std::int64_t{ 1 } << 60>>;
+			static_assert(!snct::bounds_of<Huge>.upper_bounded);
+		}
+	};
+
+	TEST_CLASS(numeric_limits)
+	{
+		TEST_METHOD(uses_the_bounds)
+		{
+			static_assert(std::numeric_limits<Percent>::is_specialized);
+			static_assert(std::numeric_limits<Percent>::min() == 0);
+			static_assert(std::numeric_limits<Percent>::max() == 100);
+			static_assert(std::numeric_limits<Probability>::lowest() == 0.0);
+			static_assert(std::numeric_limits<Probability>::max() == 1.0);
+		}
+
+		TEST_METHOD(only_has_special_values_when_allowed)
+		{
+			static_assert(!std::numeric_limits<Probability>::has_infinity);
+			static_assert(!std::numeric_limits<Probability>::has_quiet_NaN);
+			static_assert(std::numeric_limits<Positive>::has_infinity);
+			static_assert(std::numeric_limits<snct::Constrained<double, snct::AlwaysSatisfied>>::has_quiet_NaN);
+		}
+
+		TEST_METHOD(keeps_everything_else)
+		{
+			static_assert(std::numeric_limits<Probability>::digits == std::numeric_limits<double>::digits);
+			static_assert(std::numeric_limits<Percent>::is_signed);
+		}
+	};
+}
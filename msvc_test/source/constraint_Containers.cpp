@@ -0,0 +1,167 @@
+#include "CppUnitTest.h"
+#include "snct_container_constraints.hpp"
+#include "test_doubles.h"
+#include <array>
+#include <list>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace constraint::Containers
+{
+	TEST_CLASS(sizes)
+	{
+		TEST_METHOD(Size_is_exact)
+		{
+			Assert::IsTrue(snct::Size<3>::is_satisfied(std::vector<int>{ 1, 2, 3 }));
+			Assert::IsFalse(snct::Size<3>::is_satisfied(std::vector<int>{ 1, 2 }));
+			Assert::IsTrue(snct::Size<0>::is_satisfied(std::string{}));
+		}
+
+		TEST_METHOD(MinSize_and_MaxSize_are_inclusive)
+		{
+			auto const v = std::vector<int>{ 1, 2, 3 };
+			Assert::IsTrue(snct::MinSize<3>::is_satisfied(v));
+			Assert::IsFalse(snct::MinSize<4>::is_satisfied(v));
+			Assert::IsTrue(snct::MaxSize<3>::is_satisfied(v));
+			Assert::IsFalse(snct::MaxSize<2>::is_satisfied(v));
+		}
+
+		TEST_METHOD(NotEmpty)
+		{
+			Assert::IsTrue(snct::NotEmpty::is_satisfied(std::list<int>{ 1 }));
+			Assert::IsFalse(snct::NotEmpty::is_satisfied(std::vector<int>{}));
+		}
+	};
+
+	TEST_CLASS(Sorted)
+	{
+		TEST_METHOD(is_satisfied_by_ascending_ranges)
+		{
+			Assert::IsTrue(snct::Sorted::is_satisfied(std::vector<int>{}));
+			Assert::IsTrue(snct::Sorted::is_satisfied(std::vector<int>{ 1, 1, 2, 5 }));
+			Assert::IsTrue(snct::Sorted::is_satisfied(std::list<int>{ 1, 2, 3 }));
+
+			auto long_range = std::vector<int>(1000);
+			for (int i = 0; i < 1000; ++i) long_range[i] = i / 3;
+			Assert::IsTrue(snct::Sorted::is_satisfied(long_range));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_any_descent)
+		{
+			Assert::IsFalse(snct::Sorted::is_satisfied(std::list<int>{ 1, 3, 2 }));
+			for (int position : { 1, 63, 64, 65, 127, 128, 999 })
+			{
+				auto v = std::vector<int>(1000);
+				for (int i = 0; i < 1000; ++i) v[i] = i;
+				v[position] = -1;
+				Assert::IsFalse(snct::Sorted::is_satisfied(v));
+			}
+		}
+	};
+
+	TEST_CLASS(Unique)
+	{
+		TEST_METHOD(is_satisfied_by_distinct_elements)
+		{
+			Assert::IsTrue(snct::Unique::is_satisfied(std::vector<int>{}));
+			Assert::IsTrue(snct::Unique::is_satisfied(std::vector<int>{ 3, 1, 2 }));
+			Assert::IsTrue(snct::Unique::is_satisfied(std::vector<int>{ 1, 2, 3 }));
+
+			auto shuffled = std::vector<int>(500);
+			for (int i = 0; i < 500; ++i) shuffled[i] = (i * 7919) % 500;
+			Assert::IsTrue(snct::Unique::is_satisfied(shuffled));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_duplicates)
+		{
+			Assert::IsFalse(snct::Unique::is_satisfied(std::vector<int>{ 3, 1, 3 }));
+			Assert::IsFalse(snct::Unique::is_satisfied(std::vector<int>{ 1, 2, 2 }));
+
+			auto shuffled = std::vector<int>(500);
+			for (int i = 0; i < 500; ++i) shuffled[i] = (i * 7919) % 500;
+			shuffled[17] = shuffled[401];
+			Assert::IsFalse(snct::Unique::is_satisfied(shuffled));
+		}
+
+		TEST_METHOD(compares_every_pair_when_a_copy_could_throw)
+		{
+			auto names = std::vector<std::string>(200);
+			for (int i = 0; i < 200; ++i) names[i] = std::to_string((i * 7919) % 200);
+			Assert::IsTrue(snct::Unique::is_satisfied(names));
+
+			names[150] = names[3];
+			Assert::IsFalse(snct::Unique::is_satisfied(names));
+		}
+
+		TEST_METHOD(treats_NaN_as_distinct_from_everything)
+		{
+			double const nan = Doubles.at(DD::quiet_NaN);
+			Assert::IsTrue(snct::Unique::is_satisfied(std::vector<double>{ nan, nan, 1.0 }));
+			Assert::IsFalse(snct::Unique::is_satisfied(std::vector<double>{ 1.0, nan, 1.0 }));
+			Assert::IsFalse(snct::Unique::is_satisfied(std::vector<double>{ 0.0, -0.0 }));
+
+			auto values = std::vector<double>(500);
+			for (int i = 0; i < 500; ++i) values[i] = i % 5 == 0 ? nan : static_cast<double>((i * 7919) % 500);
+			Assert::IsTrue(snct::Unique::is_satisfied(values));
+
+			values[16] = -0.0;
+			values[401] = 0.0;
+			Assert::IsFalse(snct::Unique::is_satisfied(values));
+		}
+	};
+
+	TEST_CLASS(Each)
+	{
+		TEST_METHOD(is_satisfied_when_every_element_is)
+		{
+			auto const values = std::vector<double>(1000, 1.5);
+			Assert::IsTrue(snct::Each<snct::Finite>::is_satisfied(values));
+			Assert::IsTrue(snct::Each<snct::Finite>::is_satisfied(std::vector<double>{}));
+			Assert::IsTrue(snct::Each<snct::LessThan<10>>::is_satisfied(std::list<int>{ 1, 2, 9 }));
+		}
+
+		TEST_METHOD(is_not_satisfied_when_any_element_is_not)
+		{
+			for (std::size_t position : { 0, 63, 64, 500, 999 })
+			{
+				auto values = std::vector<double>(1000, 1.5);
+				values[position] = Doubles.at(DD::quiet_NaN);
+				Assert::IsFalse(snct::Each<snct::Finite>::is_satisfied(values));
+			}
+			Assert::IsFalse(snct::Each<snct::LessThan<10>>::is_satisfied(std::list<int>{ 1, 20, 9 }));
+		}
+
+		TEST_METHOD(works_with_constrained_spans)
+		{
+			using Samples = snct::Constrained<std::span<const double>, snct::NotEmpty, snct::Each<snct::Finite>>;
+			auto const good = std::vector<double>{ 1.0, 2.0 };
+			auto const bad = std::vector<double>{ 1.0, Doubles.at(DD::positive_infinity) };
+
+			Assert::IsTrue(Samples::factory(good).has_value());
+			Assert::IsFalse(Samples::factory(bad).has_value());
+		}
+	};
+
+	TEST_CLASS(constrained_references)
+	{
+		TEST_METHOD(as_in_the_readme)
+		{
+			using hour = int;
+			using Day = snct::Constrained<std::vector<hour>&, snct::Size<24>>;
+			auto hours = std::vector<hour>(24);
+
+			Assert::IsTrue(Day::factory(hours).has_value());
+			hours.pop_back();
+			Assert::IsFalse(Day::factory(hours).has_value());
+		}
+
+		TEST_METHOD(at_compile_time)
+		{
+			constexpr auto digits = std::array{ 1, 2, 3 };
+			static_assert(snct::Constrained<std::array<int, 3>, snct::Sorted, snct::Unique, snct::Each<snct::Minimum<1>>>::factory(digits).has_value());
+		}
+	};
+}
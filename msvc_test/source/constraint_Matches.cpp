@@ -0,0 +1,120 @@
+#include "CppUnitTest.h"
+#include "snct_batch.hpp"
+#include "snct_string_constraints.hpp"
+#include <string_view>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace constraint::Matches
+{
+	using Sku = snct::Matches<"[A-Z]{3}-\\d{4}">;
+	using Hostname = snct::Matches<"[a-z0-9]([a-z0-9-]{0,14}[a-z0-9])?(\\.[a-z0-9]([a-z0-9-]{0,14}[a-z0-9])?)*">;
+	using Identifier = snct::Matches<"^[A-Za-z_]\\w*$">;
+	using YesOrNo = snct::Matches<"yes|no|(maybe)+">;
+	using Anything = snct::Matches<".*">;
+	using Empty = snct::Matches<"">;
+
+	TEST_CLASS(is_satisfied_when_called_with)
+	{
+		TEST_METHOD(a_string_that_matches)
+		{
+			Assert::IsTrue(Sku::is_satisfied("ABC-1234"));
+			Assert::IsTrue(Hostname::is_satisfied("example.com"));
+			Assert::IsTrue(Hostname::is_satisfied("a.b-c.d0"));
+			Assert::IsTrue(Identifier::is_satisfied("_private"));
+			Assert::IsTrue(Identifier::is_satisfied("x"));
+			Assert::IsTrue(YesOrNo::is_satisfied("no"));
+			Assert::IsTrue(YesOrNo::is_satisfied("maybemaybe"));
+			Assert::IsTrue(Anything::is_satisfied(""));
+			Assert::IsTrue(Anything::is_satisfied("\x01\xFF anything"));
+			Assert::IsTrue(Empty::is_satisfied(""));
+		}
+	};
+
+	TEST_CLASS(is_not_satisfied_when_called_with)
+	{
+		TEST_METHOD(a_string_that_does_not_match)
+		{
+			Assert::IsFalse(Sku::is_satisfied("ABC-123"));
+			Assert::IsFalse(Sku::is_satisfied("ABC-12345"));
+			Assert::IsFalse(Sku::is_satisfied("abc-1234"));
+			Assert::IsFalse(Sku::is_satisfied(""));
+			Assert::IsFalse(Hostname::is_satisfied("-example.com"));
+			Assert::IsFalse(Hostname::is_satisfied("example..com"));
+			Assert::IsFalse(Hostname::is_satisfied("example-.com"));
+			Assert::IsFalse(Identifier::is_satisfied("1abc"));
+			Assert::IsFalse(Identifier::is_satisfied("has space"));
+			Assert::IsFalse(YesOrNo::is_satisfied("yesno"));
+			Assert::IsFalse(YesOrNo::is_satisfied(""));
+			Assert::IsFalse(Empty::is_satisfied("a"));
+		}
+
+		TEST_METHOD(a_string_that_only_partially_matches)
+		{
+			Assert::IsFalse(Sku::is_satisfied("xABC-1234"));
+			Assert::IsFalse(Sku::is_satisfied("ABC-1234x"));
+		}
+	};
+
+	TEST_CLASS(syntax)
+	{
+		TEST_METHOD(bracket_expressions)
+		{
+			Assert::IsTrue(snct::Matches<"[^a-c]+">::is_satisfied("xyz"));
+			Assert::IsFalse(snct::Matches<"[^a-c]+">::is_satisfied("xbz"));
+			Assert::IsTrue(snct::Matches<"[-a]+">::is_satisfied("-a-"));
+			Assert::IsTrue(snct::Matches<"[a-]+">::is_satisfied("a-"));
+			Assert::IsTrue(snct::Matches<"[]]">::is_satisfied("]"));
+			Assert::IsTrue(snct::Matches<"[\\d\\s]+">::is_satisfied("1 2\t3"));
+			Assert::IsTrue(snct::Matches<"[\\]\\\\]+">::is_satisfied("]\\"));
+		}
+
+		TEST_METHOD(escapes)
+		{
+			Assert::IsTrue(snct::Matches<"a\\.b">::is_satisfied("a.b"));
+			Assert::IsFalse(snct::Matches<"a\\.b">::is_satisfied("axb"));
+			Assert::IsTrue(snct::Matches<"\\D\\W\\S">::is_satisfied("a-x"));
+			Assert::IsTrue(snct::Matches<"\\(\\)\\*\\$">::is_satisfied("()*$"));
+		}
+
+		TEST_METHOD(counted_repetition)
+		{
+			using TwoToFour = snct::Matches<"a{2,4}">;
+			Assert::IsFalse(TwoToFour::is_satisfied("a"));
+			Assert::IsTrue(TwoToFour::is_satisfied("aa"));
+			Assert::IsTrue(TwoToFour::is_satisfied("aaaa"));
+			Assert::IsFalse(TwoToFour::is_satisfied("aaaaa"));
+
+			using AtLeastTwo = snct::Matches<"(ab){2,}">;
+			Assert::IsFalse(AtLeastTwo::is_satisfied("ab"));
+			Assert::IsTrue(AtLeastTwo::is_satisfied("ababab"));
+		}
+	};
+
+	TEST_CLASS(works)
+	{
+		TEST_METHOD(at_compile_time)
+		{
+			static_assert(Sku::is_satisfied("XYZ-0000"));
+			static_assert(!Sku::is_satisfied("XYZ-000"));
+		}
+
+		TEST_METHOD(with_the_factory)
+		{
+			using SkuCode = snct::Constrained<std::string_view, Sku>;
+			Assert::IsTrue(SkuCode::factory("QRS-9876").has_value());
+			Assert::IsFalse(SkuCode::factory("QRS 9876").has_value());
+		}
+
+		TEST_METHOD(on_a_batch_of_strings)
+		{
+			using SkuCode = snct::Constrained<std::string_view, Sku>;
+			auto const in = std::vector<std::string_view>{ "AAA-0001", "bad", "ZZZ-9999" };
+			bool out[3] = {};
+
+			Assert::AreEqual(std::size_t{ 2 }, snct::check_valid<SkuCode>(in, out));
+			Assert::IsTrue(out[0] && !out[1] && out[2]);
+		}
+	};
+}
@@ -0,0 +1,100 @@
+#include "CppUnitTest.h"
+#include "snct_batch.hpp"
+#include "snct_constraints.hpp"
+#include "test_doubles.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace constraint::OneOf
+{
+	using StatusCode = snct::OneOf<200, 204, 404, 500>;
+	using SmallPrime = snct::OneOf<2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47>;
+	using Offset = snct::OneOf<std::int8_t{ -128 }, std::int8_t{ -64 }, std::int8_t{ -1 }, std::int8_t{ 0 }, std::int8_t{ 1 }, std::int8_t{ 2 }, std::int8_t{ 64 }, std::int8_t{ 100 }, std::int8_t{ 127 }>;
+	using Port = snct::OneOf<22, 80, 443, 3306, 5432, 6379, 8080, 8443, 9200, 27017, 50000>;
+	using Scale = snct::OneOf<0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0>;
+	using Duplicated = snct::OneOf<10, 1000000, 10, 2000000, 3000000, 4000000, 5000000, 6000000, 7000000>;
+
+	TEST_CLASS(picks_a_strategy)
+	{
+		TEST_METHOD(from_the_set_of_values)
+		{
+			static_assert(StatusCode::strategy == snct::OneOf_Strategy::linear);
+			static_assert(SmallPrime::strategy == snct::OneOf_Strategy::bitset);
+			static_assert(Offset::strategy == snct::OneOf_Strategy::bitset);
+			static_assert(Port::strategy == snct::OneOf_Strategy::perfect_hash);
+			static_assert(Scale::strategy == snct::OneOf_Strategy::binary_search);
+			static_assert(Duplicated::strategy == snct::OneOf_Strategy::binary_search);
+		}
+	};
+
+	TEST_CLASS(is_satisfied_when_called_with)
+	{
+		TEST_METHOD(any_of_the_values)
+		{
+			for (int v : { 200, 204, 404, 500 })
+				Assert::IsTrue(StatusCode::is_satisfied(v));
+			for (int v : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47 })
+				Assert::IsTrue(SmallPrime::is_satisfied(v));
+			for (int v : { -128, -64, -1, 0, 1, 2, 64, 100, 127 })
+				Assert::IsTrue(Offset::is_satisfied(static_cast<std::int8_t>(v)));
+			for (int v : { 22, 80, 443, 3306, 5432, 6379, 8080, 8443, 9200, 27017, 50000 })
+				Assert::IsTrue(Port::is_satisfied(v));
+			for (double v : { 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0 })
+				Assert::IsTrue(Scale::is_satisfied(v));
+			for (int v : { 10, 1000000, 7000000 })
+				Assert::IsTrue(Duplicated::is_satisfied(v));
+		}
+	};
+
+	TEST_CLASS(is_not_satisfied_when_called_with)
+	{
+		TEST_METHOD(any_other_value)
+		{
+			for (int v = -100; v < 100000; ++v)
+			{
+				Assert::AreEqual(v == 200 || v == 204 || v == 404 || v == 500, StatusCode::is_satisfied(v));
+				Assert::AreEqual(v == 22 || v == 80 || v == 443 || v == 3306 || v == 5432 || v == 6379 || v == 8080 || v == 8443 || v == 9200 || v == 27017 || v == 50000, Port::is_satisfied(v));
+			}
+			for (int v = -1000; v < 1000; ++v)
+			{
+				bool const prime = v == 2 || v == 3 || v == 5 || v == 7 || v == 11 || v == 13 || v == 17 || v == 19 || v == 23 || v == 29 || v == 31 || v == 37 || v == 41 || v == 43 || v == 47;
+				Assert::AreEqual(prime, SmallPrime::is_satisfied(v));
+			}
+			for (int v = -128; v < 128; ++v)
+			{
+				bool const listed = v == -128 || v == -64 || v == -1 || v == 0 || v == 1 || v == 2 || v == 64 || v == 100 || v == 127;
+				Assert::AreEqual(listed, Offset::is_satisfied(static_cast<std::int8_t>(v)));
+			}
+			Assert::IsFalse(Scale::is_satisfied(0.0));
+			Assert::IsFalse(Scale::is_satisfied(3.0));
+			Assert::IsFalse(Scale::is_satisfied(128.0));
+			Assert::IsFalse(Scale::is_satisfied(Doubles.at(DD::quiet_NaN)));
+			Assert::IsFalse(Duplicated::is_satisfied(11));
+			Assert::IsFalse(Duplicated::is_satisfied(8000000));
+		}
+	};
+
+	TEST_CLASS(works)
+	{
+		TEST_METHOD(at_compile_time)
+		{
+			static_assert(snct::Constrained<int, Port>{ 443 }.get() == 443);
+			static_assert(!snct::Constrained<int, Port>::factory(444).has_value());
+		}
+
+		TEST_METHOD(on_a_batch_of_values)
+		{
+			using HttpStatus = snct::Constrained<int, StatusCode>;
+			auto const in = std::vector<int>{ 200, 201, 404, 500, 0 };
+			bool out[5] = {};
+
+			auto const count = snct::check_valid<HttpStatus>(in, out);
+
+			Assert::AreEqual(std::size_t{ 3 }, count);
+			Assert::IsTrue(out[0] && !out[1] && out[2] && out[3] && !out[4]);
+		}
+	};
+}
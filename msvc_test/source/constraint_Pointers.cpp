@@ -0,0 +1,69 @@
+#include "CppUnitTest.h"
+#include "snct_constraints.hpp"
+#include <type_traits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace constraint::Pointers
+{
+	TEST_CLASS(Aligned)
+	{
+		TEST_METHOD(is_satisfied_by_aligned_pointers)
+		{
+			alignas(64) float buffer[32] = {};
+			Assert::IsTrue(snct::Aligned<64>::is_satisfied(&buffer[0]));
+			Assert::IsTrue(snct::Aligned<32>::is_satisfied(&buffer[8]));
+			Assert::IsTrue(snct::Aligned<4>::is_satisfied(&buffer[1]));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_misaligned_pointers)
+		{
+			alignas(64) float buffer[32] = {};
+			Assert::IsFalse(snct::Aligned<64>::is_satisfied(&buffer[1]));
+			Assert::IsFalse(snct::Aligned<32>::is_satisfied(&buffer[9]));
+		}
+	};
+
+	TEST_CLASS(NotNull)
+	{
+		TEST_METHOD(is_Not_nullptr)
+		{
+			static_assert(std::is_same_v<snct::NotNull, snct::Not<nullptr>>);
+			int a = 0;
+			Assert::IsTrue(snct::NotNull::is_satisfied(&a));
+			Assert::IsFalse(snct::NotNull::is_satisfied(static_cast<int*>(nullptr)));
+		}
+	};
+
+	TEST_CLASS(get)
+	{
+		using Buffer = snct::Constrained<float*, snct::Aligned<32>, snct::NotNull>;
+
+		TEST_METHOD(returns_the_pointer_by_value_when_constraints_carry_assumptions)
+		{
+			alignas(32) float buffer[16] = {};
+			auto const constrained = Buffer{ buffer };
+
+			static_assert(std::is_same_v<decltype(constrained.get()), float*>);
+			Assert::IsTrue(constrained.get() == buffer);
+			Assert::IsTrue(static_cast<float* const&>(constrained) == buffer);
+		}
+
+		TEST_METHOD(returns_a_reference_otherwise)
+		{
+			auto const constrained = snct::Constrained<int, snct::LessThan<5>>{ 4 };
+			static_assert(std::is_same_v<decltype(constrained.get()), int const&>);
+
+			int value = 1;
+			auto const reference = snct::Constrained<int&>{ value };
+			static_assert(std::is_same_v<decltype(reference.get()), int const&>);
+		}
+
+		TEST_METHOD(rejects_misaligned_pointers_on_construction)
+		{
+			alignas(32) float buffer[16] = {};
+			Assert::IsFalse(Buffer::factory(buffer + 1).has_value());
+			Assert::IsFalse(Buffer::factory(nullptr).has_value());
+		}
+	};
+}
@@ -0,0 +1,136 @@
+#include "CppUnitTest.h"
+#include "snct_batch.hpp"
+#include "snct_string_constraints.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std::string_view_literals;
+
+namespace {
+	// Long enough to go through several vector blocks before reaching the interesting byte
+	std::string padded(std::string_view middle)
+	{
+		return std::string(70, 'a') + std::string(middle) + std::string(45, 'z');
+	}
+}
+
+namespace constraint::Strings
+{
+	TEST_CLASS(ValidUtf8)
+	{
+		TEST_METHOD(is_satisfied_by_well_formed_text)
+		{
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied(""));
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied("plain ascii"));
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied("S\xC3\xB8ren"));                   // U+00F8
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied("\xE2\x82\xAC"));                   // U+20AC
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied("\xF0\x9F\x98\x80"));               // U+1F600
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied("\xF4\x8F\xBF\xBF"));               // U+10FFFF
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied(padded("\xE2\x82\xAC")));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_ill_formed_text)
+		{
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied("\x80"));                          // lone continuation
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied("\xC0\xAF"));                      // overlong
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied("\xE0\x80\xAF"));                  // overlong
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied("\xED\xA0\x80"));                  // surrogate
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied("\xF4\x90\x80\x80"));              // above U+10FFFF
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied("\xE2\x82"));                      // truncated
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied("\xFF"));
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied(padded("\xE2\x82")));
+		}
+
+		TEST_METHOD(works_at_compile_time)
+		{
+			static_assert(snct::ValidUtf8::is_satisfied("S\xC3\xB8ren"));
+			static_assert(!snct::ValidUtf8::is_satisfied("\xC3"));
+		}
+	};
+
+	TEST_CLASS(Ascii)
+	{
+		TEST_METHOD(is_satisfied_by_seven_bit_text)
+		{
+			Assert::IsTrue(snct::Ascii::is_satisfied(""));
+			Assert::IsTrue(snct::Ascii::is_satisfied("hello\tworld\x7F"));
+			Assert::IsTrue(snct::Ascii::is_satisfied(padded("")));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_any_high_byte)
+		{
+			Assert::IsFalse(snct::Ascii::is_satisfied("S\xC3\xB8ren"));
+			for (std::size_t i = 0; i < 100; ++i)
+			{
+				auto s = std::string(100, 'x');
+				s[i] = '\x80';
+				Assert::IsFalse(snct::Ascii::is_satisfied(s));
+			}
+		}
+	};
+
+	TEST_CLASS(NoControlChars)
+	{
+		TEST_METHOD(is_satisfied_by_printable_text)
+		{
+			Assert::IsTrue(snct::NoControlChars::is_satisfied(""));
+			Assert::IsTrue(snct::NoControlChars::is_satisfied("printable ~ text"));
+			Assert::IsTrue(snct::NoControlChars::is_satisfied(padded("S\xC3\xB8ren")));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_any_control_char)
+		{
+			for (char c : { '\0', '\t', '\n', '\r', '\x1B', '\x1F', '\x7F' })
+			{
+				for (std::size_t i = 0; i < 100; ++i)
+				{
+					auto s = std::string(100, 'x');
+					s[i] = c;
+					Assert::IsFalse(snct::NoControlChars::is_satisfied(s));
+				}
+			}
+		}
+	};
+
+	TEST_CLASS(lengths)
+	{
+		TEST_METHOD(MaxLength_counts_bytes)
+		{
+			Assert::IsTrue(snct::MaxLength<5>::is_satisfied("hello"));
+			Assert::IsFalse(snct::MaxLength<5>::is_satisfied("hello!"));
+			Assert::IsFalse(snct::MaxLength<4>::is_satisfied("S\xC3\xB8ren"));
+		}
+
+		TEST_METHOD(NotEmpty)
+		{
+			Assert::IsTrue(snct::NotEmpty::is_satisfied("a"sv));
+			Assert::IsFalse(snct::NotEmpty::is_satisfied(""sv));
+		}
+	};
+
+	TEST_CLASS(constrained_string_views)
+	{
+		using Identifier = snct::Constrained<std::string_view, snct::NotEmpty, snct::MaxLength<16>, snct::Ascii, snct::NoControlChars>;
+
+		TEST_METHOD(use_the_factory)
+		{
+			Assert::IsTrue(Identifier::factory("user_42").has_value());
+			Assert::IsFalse(Identifier::factory("").has_value());
+			Assert::IsFalse(Identifier::factory("much_too_long_identifier").has_value());
+			Assert::IsFalse(Identifier::factory("tab\there").has_value());
+		}
+
+		TEST_METHOD(validate_in_bulk)
+		{
+			auto const in = std::vector<std::string_view>{ "ok", "", "fine", "S\xC3\xB8ren" };
+			bool out[4] = {};
+
+			auto const count = snct::check_valid<Identifier>(in, out);
+
+			Assert::AreEqual(std::size_t{ 2 }, count);
+			Assert::IsTrue(out[0] && !out[1] && out[2] && !out[3]);
+		}
+	};
+}
@@ -0,0 +1,121 @@
+#include "CppUnitTest.h"
+#include "snct_dense_map.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace dense_map
+{
+	using Port = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<4095>>;
+	using Offset = snct::Constrained<int, snct::GreaterThan<-100>, snct::LessThan<100>>;
+	using Map = snct::DenseMap<Port, std::string>;
+
+	TEST_CLASS(DenseMap)
+	{
+		TEST_METHOD(is_sized_from_the_key_bounds)
+		{
+			static_assert(Map::capacity == 4096);
+			static_assert(snct::DenseMap<Offset, int>::capacity == 199);
+			static_assert(std::forward_iterator<Map::iterator>);
+			static_assert(std::forward_iterator<Map::const_iterator>);
+		}
+
+		TEST_METHOD(starts_empty)
+		{
+			Map const map;
+			Assert::IsTrue(map.empty());
+			Assert::IsFalse(map.contains(Port{ 0 }));
+			Assert::IsTrue(map.begin() == map.end());
+		}
+
+		TEST_METHOD(inserts_and_finds_values)
+		{
+			Map map;
+			Assert::IsTrue(map.try_emplace(Port{ 80 }, "http").second);
+			Assert::IsFalse(map.try_emplace(Port{ 80 }, "other").second);
+			map[Port{ 443 }] = "https";
+
+			Assert::AreEqual(std::size_t{ 2 }, map.size());
+			Assert::IsTrue(map.contains(Port{ 443 }));
+			Assert::AreEqual(std::string{ "http" }, (*map.find(Port{ 80 })).second);
+			Assert::IsTrue(map.find(Port{ 81 }) == map.end());
+		}
+
+		TEST_METHOD(assigns_existing_values)
+		{
+			Map map;
+			Assert::IsTrue(map.insert_or_assign(Port{ 22 }, "ssh").second);
+			Assert::IsFalse(map.insert_or_assign(Port{ 22 }, "sftp").second);
+			Assert::AreEqual(std::string{ "sftp" }, map[Port{ 22 }]);
+		}
+
+		TEST_METHOD(erases_values)
+		{
+			Map map;
+			map[Port{ 1 }] = "one";
+			Assert::AreEqual(std::size_t{ 1 }, map.erase(Port{ 1 }));
+			Assert::AreEqual(std::size_t{ 0 }, map.erase(Port{ 1 }));
+			Assert::IsTrue(map.empty());
+		}
+
+		TEST_METHOD(iterates_in_key_order)
+		{
+			snct::DenseMap<Offset, int> map;
+			for (int k : { 99, -99, 0, 63, 64, -1 })
+				map[Offset{ k }] = k * 2;
+
+			std::vector<int> keys;
+			for (auto [key, value] : map)
+			{
+				keys.push_back(key.get());
+				Assert::AreEqual(key.get() * 2, value);
+			}
+			Assert::IsTrue(keys == std::vector<int>{ -99, -1, 0, 63, 64, 99 });
+		}
+
+		TEST_METHOD(modifies_values_through_iterators)
+		{
+			snct::DenseMap<Offset, int> map;
+			map[Offset{ 5 }] = 1;
+			for (auto [key, value] : map)
+				value = 42;
+			Assert::AreEqual(42, map[Offset{ 5 }]);
+		}
+
+		TEST_METHOD(copies_and_moves)
+		{
+			Map map;
+			map[Port{ 4095 }] = "last";
+
+			Map copy = map;
+			copy[Port{ 0 }] = "first";
+			Assert::AreEqual(std::size_t{ 1 }, map.size());
+			Assert::AreEqual(std::size_t{ 2 }, copy.size());
+
+			Map moved = std::move(copy);
+			Assert::AreEqual(std::string{ "first" }, moved[Port{ 0 }]);
+
+			copy = moved;
+			Assert::AreEqual(std::size_t{ 2 }, copy.size());
+		}
+
+		TEST_METHOD(destroys_values)
+		{
+			auto const counter = std::make_shared<int>(0);
+			{
+				snct::DenseMap<Port, std::shared_ptr<int>> map;
+				map[Port{ 3 }] = counter;
+				map[Port{ 4 }] = counter;
+				Assert::AreEqual(3L, counter.use_count());
+				map.erase(Port{ 3 });
+				Assert::AreEqual(2L, counter.use_count());
+			}
+			Assert::AreEqual(1L, counter.use_count());
+		}
+	};
+}
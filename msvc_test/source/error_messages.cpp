@@ -0,0 +1,132 @@
+#include "CppUnitTest.h"
+#include "snct_constraints.hpp"
+#include "snct_container_constraints.hpp"
+#include "snct_string_constraints.hpp"
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	enum class Colour { red = 1, green = 2 };
+
+	struct Even
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t % 2 == 0; }
+		inline static const char* error_message() noexcept { return "odd number"; }
+	};
+
+	template<typename Alias, typename V>
+	std::string what_of(V value)
+	{
+		try {
+			Alias{ value };
+		}
+		catch (snct::Constraint_Exception const& e) {
+			return e.what();
+		}
+		return {};
+	}
+}
+
+namespace error_messages
+{
+	TEST_CLASS(constraint_messages)
+	{
+		TEST_METHOD(name_integer_arguments)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::LessThan<5>' was violated" }, std::string{ snct::LessThan<5>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::Minimum<-12>' was violated" }, std::string{ snct::Minimum<-12>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::MultipleOf<8>' was violated" }, std::string{ snct::MultipleOf<8>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::Satisfied<false>' was violated" }, std::string{ snct::Satisfied<false>::error_message() });
+		}
+
+		TEST_METHOD(handle_extreme_and_enum_arguments)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::GreaterThan<-9223372036854775808>' was violated" },
+				std::string{ snct::GreaterThan<std::numeric_limits<std::int64_t>::min()>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::Not<2>' was violated" }, std::string{ snct::Not<Colour::green>::error_message() });
+		}
+
+		TEST_METHOD(name_the_constraint_Each_applies)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::Each<snct::LessThan<10>>' was violated" }, std::string{ snct::Each<snct::LessThan<10>>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::Each<snct::Finite>' was violated" }, std::string{ snct::Each<snct::Finite>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::Each' was violated: odd number" }, std::string{ snct::Each<Even>::error_message() });
+		}
+
+		TEST_METHOD(list_every_value_of_OneOf)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::OneOf<1, 2, 3>' was violated" }, std::string{ snct::OneOf<1, 2, 3>::error_message() });
+		}
+
+		TEST_METHOD(cut_long_argument_lists_short)
+		{
+			std::string const message = snct::OneOf<
+				1000000000, 1000000001, 1000000002, 1000000003, 1000000004, 1000000005, 1000000006, 1000000007, 1000000008, 1000000009,
+				1000000010, 1000000011, 1000000012, 1000000013, 1000000014, 1000000015, 1000000016, 1000000017, 1000000018, 1000000019>::error_message();
+			Assert::IsTrue(message.size() < 256);
+			Assert::IsTrue(message.find(", ...>' was violated") != std::string::npos);
+		}
+
+		TEST_METHOD(name_sizes_and_patterns)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::MaxSize<16>' was violated" }, std::string{ snct::MaxSize<16>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::MaxLength<80>' was violated" }, std::string{ snct::MaxLength<80>::error_message() });
+			Assert::AreEqual(std::string{ "Constraint 'snct::Matches<\"[a-z]+\">' was violated" }, std::string{ snct::Matches<"[a-z]+">::error_message() });
+		}
+
+		TEST_METHOD(show_other_arguments_as_value)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::LessThan<value>' was violated" }, std::string{ snct::LessThan<1.5>::error_message() });
+		}
+
+		TEST_METHOD(are_compile_time_constants)
+		{
+			static_assert(snct::detail::violation_message<"snct::Maximum", 7>.size() == sizeof("Constraint 'snct::Maximum<7>' was violated"));
+			Assert::IsTrue(snct::Maximum<7>::error_message() == snct::Maximum<7>::error_message());
+		}
+	};
+
+	TEST_CLASS(exception_what)
+	{
+		TEST_METHOD(appends_the_rejected_integer)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::LessThan<5>' was violated (value: 7)" },
+				what_of<snct::Constrained<int, snct::LessThan<5>>>(7));
+			Assert::AreEqual(std::string{ "Constraint 'snct::Minimum<0>' was violated (value: -3)" },
+				what_of<snct::Constrained<long long, snct::Minimum<0ll>>>(-3ll));
+		}
+
+		TEST_METHOD(appends_floating_point_bool_and_pointer_values)
+		{
+			Assert::AreEqual(std::string{ "Constraint 'snct::LessThan<value>' was violated (value: 2.5)" },
+				what_of<snct::Constrained<double, snct::LessThan<1.5>>>(2.5));
+			Assert::AreEqual(std::string{ "Constraint 'snct::Satisfied<false>' was violated (value: true)" },
+				what_of<snct::Constrained<bool, snct::Satisfied<false>>>(true));
+			Assert::AreEqual(std::string{ "Constraint 'snct::Not<nullptr>' was violated. (value: nullptr)" },
+				what_of<snct::Constrained<int*, snct::NotNull>>(static_cast<int*>(nullptr)));
+		}
+
+		TEST_METHOD(leaves_out_values_it_cannot_keep)
+		{
+			auto const e = snct::Constraint_Exception{ "message", std::string{ "text" } };
+			Assert::AreEqual(std::string{ "message" }, std::string{ e.what() });
+		}
+
+		TEST_METHOD(keeps_the_bare_message_available)
+		{
+			try {
+				snct::Constrained<int, snct::Maximum<3>>{ 4 };
+			}
+			catch (snct::Constraint_Exception const& e) {
+				Assert::AreEqual(std::string{ "Constraint 'snct::Maximum<3>' was violated" }, std::string{ e.error_message() });
+				Assert::AreEqual(std::string{ e.what() }, std::string{ e.what() });
+				return;
+			}
+			Assert::Fail();
+		}
+	};
+}
@@ -0,0 +1,118 @@
+#include "CppUnitTest.h"
+#include "snct_constraints.hpp"
+#include "snct_string_constraints.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	int expensive_checks = 0;
+
+	// Stands in for something like a checksum over a buffer
+	struct Checksum
+	{
+		static bool is_satisfied(int t) noexcept { ++expensive_checks; return t % 7 == 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Checksum' was violated"; }
+		static constexpr double cost = 100;
+	};
+
+	struct Rare
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t != 13; }
+		inline static const char* error_message() noexcept { return "Constraint 'Rare' was violated"; }
+		static constexpr double rejection_rate = 0.01;
+	};
+
+	struct Common
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t % 2 == 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Common' was violated"; }
+		static constexpr double rejection_rate = 0.9;
+	};
+
+	struct Never
+	{
+		constexpr static bool is_satisfied(int) noexcept { return true; }
+		inline static const char* error_message() noexcept { return "Constraint 'Never' was violated"; }
+		static constexpr double rejection_rate = 0;
+	};
+
+	using Checked = snct::Constrained<int, Checksum, snct::Minimum<0>>;
+
+	template<typename ... C>
+	constexpr auto order = snct::detail::evaluation_order<C...>();
+}
+
+namespace evaluation_order
+{
+	TEST_CLASS(hints)
+	{
+		TEST_METHOD(are_recognized)
+		{
+			Assert::IsTrue(snct::Costed_Constraint<Checksum>);
+			Assert::IsFalse(snct::Costed_Constraint<Rare>);
+			Assert::IsTrue(snct::Selective_Constraint<Rare>);
+			Assert::IsFalse(snct::Selective_Constraint<snct::Minimum<0>>);
+		}
+
+		TEST_METHOD(without_hints_keep_declaration_order)
+		{
+			static_assert(order<snct::Minimum<0>, snct::Maximum<9>, snct::NotNaN> == std::array<std::size_t, 3>{ 0, 1, 2 });
+			static_assert(order<>.empty());
+		}
+
+		TEST_METHOD(put_cheap_constraints_first)
+		{
+			static_assert(order<Checksum, snct::Minimum<0>> == std::array<std::size_t, 2>{ 1, 0 });
+			static_assert(order<snct::Matches<"[a-z]+">, snct::MaxLength<64>> == std::array<std::size_t, 2>{ 1, 0 });
+		}
+
+		TEST_METHOD(put_selective_constraints_first)
+		{
+			static_assert(order<Rare, snct::Minimum<0>, Common> == std::array<std::size_t, 3>{ 2, 1, 0 });
+		}
+
+		TEST_METHOD(put_constraints_that_never_reject_last)
+		{
+			static_assert(order<Never, Checksum> == std::array<std::size_t, 2>{ 1, 0 });
+		}
+	};
+
+	TEST_CLASS(constrained)
+	{
+		TEST_METHOD(factory_skips_expensive_checks_for_values_a_cheap_check_rejects)
+		{
+			expensive_checks = 0;
+			Assert::IsFalse(Checked::factory(-7).has_value());
+			Assert::AreEqual(0, expensive_checks);
+
+			Assert::IsTrue(Checked::factory(14).has_value());
+			Assert::AreEqual(1, expensive_checks);
+		}
+
+		TEST_METHOD(constructor_throws_for_the_first_constraint_checked)
+		{
+			expensive_checks = 0;
+			try {
+				Checked{ -1 };
+			}
+			catch (snct::Constraint_Exception const& e) {
+				Assert::AreEqual(std::string{ snct::Minimum<0>::error_message() }, std::string{ e.error_message() });
+				Assert::AreEqual(0, expensive_checks);
+				return;
+			}
+			Assert::Fail();
+		}
+
+		TEST_METHOD(still_works_at_compile_time)
+		{
+			constexpr auto value = snct::Constrained<int, Rare, Common>{ 4 };
+			static_assert(value.get() == 4);
+			static_assert(!snct::Constrained<int, Rare, Common>::satisfies_constraints(13));
+		}
+	};
+}
@@ -0,0 +1,122 @@
+#include "CppUnitTest.h"
+#include "snct_failure_log.hpp"
+#include "snct_constraints.hpp"
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	struct Positive
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t > 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Positive' was violated"; }
+	};
+
+	struct Odd
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t % 2 != 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Odd' was violated"; }
+	};
+
+	using Logged = snct::Constrained<int, Positive, Odd>;
+	using Unlogged = snct::Constrained<int, Positive>;
+}
+
+namespace snct
+{
+	template<>
+	inline constexpr bool logs_failures<Logged> = true;
+}
+
+namespace failure_log
+{
+	TEST_CLASS(source_location)
+	{
+		TEST_METHOD(is_carried_by_the_exception)
+		{
+			std::uint_least32_t line = 0;
+			try {
+				line = std::source_location::current().line(); Unlogged{ -1 };
+			}
+			catch (snct::Constraint_Exception const& e) {
+				Assert::AreEqual(line, e.where().line());
+				Assert::AreEqual(std::string{ std::source_location::current().file_name() }, std::string{ e.where().file_name() });
+				return;
+			}
+			Assert::Fail();
+		}
+	};
+
+	TEST_CLASS(drain_failure_log)
+	{
+		TEST_METHOD(returns_rejections_with_their_call_sites)
+		{
+			(void)snct::drain_failure_log();
+
+			auto const factory_line = std::source_location::current().line() + 1;
+			(void)Logged::factory(4);
+			(void)Logged::factory(3);
+
+			std::uint_least32_t constructor_line = 0;
+			try {
+				constructor_line = std::source_location::current().line(); Logged{ -3 };
+			}
+			catch (snct::Constraint_Exception const&) {}
+
+			auto const failures = snct::drain_failure_log();
+			Assert::AreEqual(std::size_t{ 2 }, failures.size());
+
+			Assert::IsTrue(*failures[0].alias == typeid(Logged));
+			Assert::AreEqual(std::string{ "Constraint 'Odd' was violated" }, std::string{ failures[0].error_message });
+			Assert::AreEqual(factory_line, failures[0].line);
+
+			Assert::AreEqual(std::string{ "Constraint 'Positive' was violated" }, std::string{ failures[1].error_message });
+			Assert::AreEqual(constructor_line, failures[1].line);
+			Assert::AreEqual(std::string{ std::source_location::current().file_name() }, std::string{ failures[1].file_name });
+		}
+
+		TEST_METHOD(is_empty_after_draining)
+		{
+			(void)Logged::factory(0);
+			(void)snct::drain_failure_log();
+			Assert::IsTrue(snct::drain_failure_log().empty());
+		}
+
+		TEST_METHOD(keeps_only_the_most_recent_failures)
+		{
+			(void)snct::drain_failure_log();
+			for (std::size_t i = 0; i < snct::failure_log_capacity + 10; ++i)
+				(void)Logged::factory(-static_cast<int>(i));
+
+			Assert::AreEqual(snct::failure_log_capacity, snct::drain_failure_log().size());
+		}
+
+		TEST_METHOD(collects_failures_from_every_thread)
+		{
+			(void)snct::drain_failure_log();
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+				threads.emplace_back([] {
+					for (int i = 0; i < 50; ++i)
+						(void)Logged::factory(2);
+				});
+			for (auto& thread : threads)
+				thread.join();
+
+			Assert::AreEqual(std::size_t{ 200 }, snct::drain_failure_log().size());
+		}
+
+		TEST_METHOD(is_off_by_default)
+		{
+			(void)snct::drain_failure_log();
+			(void)Unlogged::factory(-1);
+			Assert::IsTrue(snct::drain_failure_log().empty());
+		}
+	};
+}
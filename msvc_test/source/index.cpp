@@ -0,0 +1,93 @@
+#include "CppUnitTest.h"
+#include "snct_index.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace bounded_index
+{
+	TEST_CLASS(Index)
+	{
+		TEST_METHOD(accepts_values_below_the_bound)
+		{
+			Assert::IsTrue(snct::Index<4>::satisfies_constraints(0));
+			Assert::IsTrue(snct::Index<4>::satisfies_constraints(3));
+		}
+
+		TEST_METHOD(rejects_values_at_or_above_the_bound)
+		{
+			Assert::IsFalse(snct::Index<4>::satisfies_constraints(4));
+			Assert::IsFalse(snct::Index<4>::factory(100).has_value());
+			Assert::IsFalse(snct::Index<0>::satisfies_constraints(0));
+		}
+	};
+
+	TEST_CLASS(at)
+	{
+		TEST_METHOD(reads_and_writes_arrays)
+		{
+			std::array<int, 4> a{ 10, 20, 30, 40 };
+			Assert::AreEqual(30, snct::at(a, snct::Index<4>{ 2 }));
+
+			snct::at(a, snct::Index<4>{ 3 }) = 7;
+			Assert::AreEqual(7, a[3]);
+
+			std::array<int, 4> const& c = a;
+			Assert::AreEqual(10, snct::at(c, snct::Index<4>{ 0 }));
+		}
+
+		TEST_METHOD(reads_and_writes_fixed_size_spans)
+		{
+			int raw[3] = { 1, 2, 3 };
+			std::span<int, 3> s{ raw };
+			snct::at(s, snct::Index<3>{ 1 }) = 5;
+			Assert::AreEqual(5, raw[1]);
+			Assert::AreEqual(3, snct::at(raw, snct::Index<3>{ 2 }));
+		}
+
+		TEST_METHOD(works_at_compile_time)
+		{
+			constexpr std::array<int, 3> a{ 4, 5, 6 };
+			static_assert(snct::at(a, snct::Index<3>{ 1 }) == 5);
+		}
+	};
+
+	TEST_CLASS(indices)
+	{
+		TEST_METHOD(yields_every_index_in_order)
+		{
+			std::size_t expected = 0;
+			for (snct::Index<5> i : snct::indices<5>())
+				Assert::AreEqual(expected++, i.get());
+			Assert::AreEqual(std::size_t{ 5 }, expected);
+		}
+
+		TEST_METHOD(is_empty_for_no_elements)
+		{
+			auto const r = snct::indices<0>();
+			Assert::IsTrue(r.begin() == r.end());
+		}
+
+		TEST_METHOD(is_a_forward_range)
+		{
+			static_assert(std::forward_iterator<snct::Index_Range<3>::iterator>);
+			auto const r = snct::indices<8>();
+			Assert::AreEqual(std::ptrdiff_t{ 8 }, std::distance(r.begin(), r.end()));
+		}
+
+		TEST_METHOD(indexes_a_lookup_table)
+		{
+			constexpr std::array<int, 4> squares = [] {
+				std::array<int, 4> s{};
+				for (auto i : snct::indices<4>())
+					snct::at(s, i) = static_cast<int>(i.get() * i.get());
+				return s;
+			}();
+			static_assert(squares[3] == 9);
+		}
+	};
+}
@@ -0,0 +1,134 @@
+#include "CppUnitTest.h"
+#include "snct_integer_math.hpp"
+#include <cstddef>
+#include <cstdint>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace integer_math
+{
+	using RingSize = snct::Constrained<std::size_t, snct::PowerOfTwo>;
+	using BlockSize = snct::Constrained<std::uint32_t, snct::PowerOfTwo, snct::Minimum<std::uint32_t{ 16 }>>;
+
+	TEST_CLASS(PowerOfTwo)
+	{
+		TEST_METHOD(is_satisfied_by_powers_of_two)
+		{
+			Assert::IsTrue(snct::PowerOfTwo::is_satisfied(1));
+			Assert::IsTrue(snct::PowerOfTwo::is_satisfied(std::size_t{ 1024 }));
+			Assert::IsTrue(snct::PowerOfTwo::is_satisfied(std::int64_t{ 1 } << 62));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_anything_else)
+		{
+			Assert::IsFalse(snct::PowerOfTwo::is_satisfied(0));
+			Assert::IsFalse(snct::PowerOfTwo::is_satisfied(6));
+			Assert::IsFalse(snct::PowerOfTwo::is_satisfied(-4));
+			Assert::IsFalse(snct::PowerOfTwo::is_satisfied(std::int64_t{ -1 } << 63));
+		}
+	};
+
+	TEST_CLASS(MultipleOf)
+	{
+		TEST_METHOD(is_satisfied_by_multiples)
+		{
+			Assert::IsTrue(snct::MultipleOf<3>::is_satisfied(0));
+			Assert::IsTrue(snct::MultipleOf<3>::is_satisfied(-9));
+			Assert::IsTrue(snct::MultipleOf<16>::is_satisfied(std::size_t{ 4096 }));
+		}
+
+		TEST_METHOD(is_not_satisfied_by_anything_else)
+		{
+			Assert::IsFalse(snct::MultipleOf<3>::is_satisfied(-10));
+			Assert::IsFalse(snct::MultipleOf<16>::is_satisfied(std::size_t{ 4097 }));
+		}
+
+		TEST_METHOD(takes_factors_that_do_not_fit_the_value_type)
+		{
+			Assert::IsTrue(snct::MultipleOf<256>::is_satisfied(std::uint8_t{ 0 }));
+			Assert::IsFalse(snct::MultipleOf<256>::is_satisfied(std::uint8_t{ 3 }));
+			Assert::IsFalse(snct::MultipleOf<200>::is_satisfied(std::int8_t{ -56 }));
+			Assert::IsTrue(snct::MultipleOf<std::uint64_t{ 1 } << 40>::is_satisfied(std::int64_t{ -1 } << 41));
+			Assert::IsTrue(snct::MultipleOf<4>::is_satisfied(std::int8_t{ -128 }));
+
+			using Byte = snct::Constrained<std::uint8_t, snct::MultipleOf<256>>;
+			Assert::IsFalse(Byte::satisfies_constraints(std::uint8_t{ 3 }));
+		}
+	};
+
+	TEST_CLASS(power_of_two_helpers)
+	{
+		TEST_METHOD(agree_with_division)
+		{
+			for (std::size_t size = 1; size <= 4096; size *= 2)
+			{
+				auto const ring = RingSize{ size };
+				for (std::size_t x : { std::size_t{ 0 }, std::size_t{ 1 }, std::size_t{ 4095 }, std::size_t{ 12345 }, ~std::size_t{ 0 } })
+				{
+					Assert::AreEqual(x % size, snct::mod(x, ring));
+					Assert::AreEqual(x / size, snct::div(x, ring));
+					Assert::AreEqual(x / size * size, snct::round_down(x, ring));
+				}
+				Assert::AreEqual((std::size_t{ 12345 } + size - 1) / size * size, snct::round_up(12345, ring));
+			}
+		}
+
+		TEST_METHOD(work_with_other_constraints_in_the_pack)
+		{
+			auto const block = BlockSize{ 64u };
+			Assert::AreEqual(std::uint32_t{ 36 }, snct::mod(100, block));
+			Assert::AreEqual(std::uint32_t{ 1 }, snct::div(100, block));
+		}
+
+		TEST_METHOD(work_at_compile_time)
+		{
+			static_assert(snct::mod(13, RingSize{ 8 }) == 5);
+		}
+	};
+
+	TEST_CLASS(divide_exact)
+	{
+		TEST_METHOD(agrees_with_division_for_unsigned_values)
+		{
+			using Stride = snct::Constrained<std::uint32_t, snct::MultipleOf<24u>>;
+			for (std::uint32_t x = 0; x < 100000; x += 24)
+			{
+				Assert::AreEqual(x / 24, snct::divide_exact<24u>(Stride{ x }));
+				Assert::AreEqual(x / 3, snct::divide_exact<3u>(Stride{ x }));
+				Assert::AreEqual(x / 8, snct::divide_exact<8u>(Stride{ x }));
+			}
+		}
+
+		TEST_METHOD(agrees_with_division_for_signed_values)
+		{
+			using Offset = snct::Constrained<int, snct::MultipleOf<6>>;
+			for (int x = -60000; x < 60000; x += 6)
+				Assert::AreEqual(x / 6, snct::divide_exact<6>(Offset{ x }));
+		}
+
+		TEST_METHOD(agrees_with_division_for_narrow_types)
+		{
+			using Byte = snct::Constrained<std::uint8_t, snct::MultipleOf<std::uint8_t{ 3 }>>;
+			for (unsigned x = 0; x <= 255; x += 3)
+				Assert::AreEqual(static_cast<std::uint8_t>(x / 3), snct::divide_exact<3>(Byte{ static_cast<std::uint8_t>(x) }));
+
+			using Word = snct::Constrained<std::uint16_t, snct::MultipleOf<std::uint16_t{ 3 }>>;
+			for (unsigned x = 0; x <= 65535; x += 3)
+				Assert::AreEqual(static_cast<std::uint16_t>(x / 3), snct::divide_exact<3>(Word{ static_cast<std::uint16_t>(x) }));
+			static_assert(snct::divide_exact<3>(Word{ std::uint16_t{ 65535 } }) == 21845);
+
+			using Signed_Word = snct::Constrained<std::int16_t, snct::MultipleOf<std::int16_t{ 12 }>>;
+			for (int x = -32760; x <= 32760; x += 12)
+			{
+				Assert::AreEqual(static_cast<std::int16_t>(x / 12), snct::divide_exact<12>(Signed_Word{ static_cast<std::int16_t>(x) }));
+				Assert::AreEqual(static_cast<std::int16_t>(x / 3), snct::divide_exact<3>(Signed_Word{ static_cast<std::int16_t>(x) }));
+			}
+		}
+
+		TEST_METHOD(combines_factors_from_several_constraints)
+		{
+			using Both = snct::Constrained<int, snct::MultipleOf<4>, snct::MultipleOf<5>>;
+			static_assert(snct::divide_exact<20>(Both{ 140 }) == 7);
+		}
+	};
+}
@@ -2,6 +2,8 @@
 #include "snct_constexpr_math.hpp"
 #include "test_doubles.h"
 #include <array>
+#include <cmath>
+#include <limits>
 #include <utility>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -796,4 +798,64 @@ namespace constexpr_math_function
 			}
 		};
 	}
+
+
+
+	namespace next_up
+	{
+		TEST_CLASS(returns)
+		{
+			TEST_METHOD(the_next_larger_value_on_finite_input)
+			{
+				Assert::IsTrue(snct::next_up(1.0) > 1.0);
+				Assert::IsTrue(snct::next_up(-1.0) > -1.0);
+				Assert::AreEqual(1.0, snct::next_down(snct::next_up(1.0)));
+				Assert::AreEqual(Doubles.at(DD::positive_denormalized_min), snct::next_up(Doubles.at(DD::zero)));
+				Assert::AreEqual(Doubles.at(DD::positive_infinity), snct::next_up(Doubles.at(DD::positive_max)));
+			}
+
+			TEST_METHOD(the_input_on_positive_infinity)
+			{
+				Assert::AreEqual(Doubles.at(DD::positive_infinity), snct::next_up(Doubles.at(DD::positive_infinity)));
+			}
+
+			TEST_METHOD(NaN_on_NaN)
+			{
+				Assert::IsTrue(snct::is_nan(snct::next_up(Doubles.at(DD::quiet_NaN))));
+			}
+
+			TEST_METHOD(the_same_as_nextafter_for_long_double)
+			{
+				using Limits = std::numeric_limits<long double>;
+				constexpr std::array values{ 1.0L, -1.0L, 0.1L, -3.5L, 1e300L, -1e-300L, Limits::min(), -Limits::min(),
+					Limits::denorm_min(), -Limits::denorm_min(), Limits::max(), Limits::lowest(), 0.0L, -Limits::infinity() };
+				for (long double const value : values)
+				{
+					Assert::IsTrue(std::nextafter(value, Limits::infinity()) == snct::next_up(value));
+					Assert::IsTrue(std::nextafter(value, -Limits::infinity()) == snct::next_down(value));
+				}
+				static_assert(snct::next_down(snct::next_up(1.0L)) == 1.0L);
+			}
+		};
+	}
+
+
+
+	namespace next_down
+	{
+		TEST_CLASS(returns)
+		{
+			TEST_METHOD(the_next_smaller_value_on_finite_input)
+			{
+				Assert::IsTrue(snct::next_down(1.0) < 1.0);
+				Assert::IsTrue(snct::next_down(-1.0) < -1.0);
+				Assert::AreEqual(Doubles.at(DD::negative_denormalized_min), snct::next_down(Doubles.at(DD::zero)));
+			}
+
+			TEST_METHOD(the_input_on_negative_infinity)
+			{
+				Assert::AreEqual(Doubles.at(DD::negative_infinity), snct::next_down(Doubles.at(DD::negative_infinity)));
+			}
+		};
+	}
 }
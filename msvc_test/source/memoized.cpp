@@ -0,0 +1,158 @@
+#include "CppUnitTest.h"
+#include "snct_memoized.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	std::atomic<int> schema_checks{ 0 };
+
+	// Versions come from one counter, so a document never shares a generation with an earlier one
+	// that lived at the same address
+	std::atomic<std::uint64_t> last_version{ 0 };
+
+	struct Document
+	{
+		std::vector<int> fields;
+		std::uint64_t version = ++last_version;
+
+		std::uint64_t generation() const noexcept { return version; }
+		void set(std::size_t i, int value) { fields[i] = value; version = ++last_version; }
+	};
+
+	// Stands in for a schema check that walks the whole document
+	struct ValidSchema
+	{
+		static bool is_satisfied(Document const& d) noexcept
+		{
+			++schema_checks;
+			for (int f : d.fields)
+				if (f < 0)
+					return false;
+			return true;
+		}
+		inline static const char* error_message() noexcept { return "Constraint 'ValidSchema' was violated"; }
+	};
+
+	struct Record
+	{
+		int value;
+		std::uint64_t revision;
+	};
+
+	struct Positive_Record
+	{
+		static bool is_satisfied(Record const& r) noexcept { ++schema_checks; return r.value > 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Positive_Record' was violated"; }
+	};
+
+	struct Revision_Of
+	{
+		std::uint64_t operator()(Record const& r) const noexcept { return r.revision; }
+	};
+
+	using Checked_Document = snct::Constrained<Document const&, snct::Memoized<ValidSchema>>;
+	using Checked_Record = snct::Constrained<Record const&, snct::Memoized<Positive_Record, Revision_Of>>;
+}
+
+namespace memoized
+{
+	TEST_CLASS(memoized)
+	{
+		TEST_METHOD(checks_an_unchanged_object_once)
+		{
+			schema_checks = 0;
+			auto const document = Document{ { 1, 2, 3 } };
+			for (int i = 0; i < 100; ++i)
+				Assert::IsTrue(Checked_Document::factory(document).has_value());
+			Assert::AreEqual(1, schema_checks.load());
+		}
+
+		TEST_METHOD(checks_again_after_the_generation_changes)
+		{
+			schema_checks = 0;
+			auto document = Document{ { 1, 2, 3 } };
+			Assert::IsTrue(Checked_Document::factory(document).has_value());
+
+			document.set(1, -2);
+			Assert::IsFalse(Checked_Document::factory(document).has_value());
+			Assert::IsFalse(Checked_Document::factory(document).has_value());
+			Assert::AreEqual(2, schema_checks.load());
+		}
+
+		TEST_METHOD(remembers_rejections)
+		{
+			schema_checks = 0;
+			auto const document = Document{ { -1 } };
+			for (int i = 0; i < 3; ++i)
+			{
+				try {
+					Checked_Document{ document };
+					Assert::Fail();
+				}
+				catch (snct::Constraint_Exception const& e) {
+					Assert::AreEqual(std::string{ "Constraint 'ValidSchema' was violated" }, std::string{ e.error_message() });
+				}
+			}
+			Assert::AreEqual(1, schema_checks.load());
+		}
+
+		TEST_METHOD(tells_objects_apart)
+		{
+			schema_checks = 0;
+			auto const good = Document{ { 1 } };
+			auto const bad = Document{ { -1 } };
+			for (int i = 0; i < 10; ++i)
+			{
+				Assert::IsTrue(Checked_Document::factory(good).has_value());
+				Assert::IsFalse(Checked_Document::factory(bad).has_value());
+			}
+			Assert::AreEqual(2, schema_checks.load());
+		}
+
+		TEST_METHOD(takes_a_custom_generation)
+		{
+			schema_checks = 0;
+			auto record = Record{ 5, ++last_version };
+			(void)Checked_Record::factory(record);
+			(void)Checked_Record::factory(record);
+			Assert::AreEqual(1, schema_checks.load());
+
+			record = Record{ -5, ++last_version };
+			Assert::IsFalse(Checked_Record::factory(record).has_value());
+			Assert::AreEqual(2, schema_checks.load());
+		}
+
+		TEST_METHOD(is_consistent_across_threads)
+		{
+			std::vector<Document> documents;
+			for (int i = 0; i < 64; ++i)
+				documents.push_back(Document{ { i % 3 == 0 ? -1 - i : i } });
+
+			std::atomic<int> wrong{ 0 };
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+				threads.emplace_back([&] {
+					for (int round = 0; round < 200; ++round)
+						for (int i = 0; i < 64; ++i)
+							if (Checked_Document::factory(documents[i]).has_value() != (i % 3 != 0))
+								++wrong;
+				});
+			for (auto& thread : threads)
+				thread.join();
+
+			Assert::AreEqual(0, wrong.load());
+		}
+
+		TEST_METHOD(is_an_identity_constraint)
+		{
+			Assert::IsTrue(snct::Identity_Constraint<snct::Memoized<ValidSchema>>);
+			Assert::IsFalse(snct::Identity_Constraint<ValidSchema>);
+		}
+	};
+}
@@ -0,0 +1,178 @@
+#include "CppUnitTest.h"
+#include "snct_container_constraints.hpp"
+#include "snct_string_constraints.hpp"
+#include <cstddef>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	std::size_t full_checks = 0;
+	std::size_t appended_from = 0;
+
+	struct Counted_Full
+	{
+		static bool is_satisfied(std::vector<int> const&) noexcept { ++full_checks; return true; }
+		inline static const char* error_message() noexcept { return "Constraint 'Counted_Full' was violated"; }
+	};
+
+	struct Counted_Append
+	{
+		static bool is_satisfied(std::vector<int> const&) noexcept { ++full_checks; return true; }
+		static bool is_satisfied_after_append(std::vector<int> const&, std::size_t old_size) noexcept { appended_from = old_size; return true; }
+		inline static const char* error_message() noexcept { return "Constraint 'Counted_Append' was violated"; }
+	};
+
+	using Percent = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<100>>;
+	using Ascending = snct::Constrained<std::vector<int>, snct::Sorted, snct::MaxSize<8>>;
+	using Ascending_Ref = snct::Constrained<std::vector<int>&, snct::Sorted>;
+	using Naturals = snct::Constrained<std::vector<int>, snct::Each<snct::Minimum<0>>>;
+	using Text = snct::Constrained<std::string, snct::Ascii, snct::NoControlChars>;
+
+	template<typename F>
+	bool throws_constraint_exception(F f)
+	{
+		try {
+			f();
+		}
+		catch (snct::Constraint_Exception const&) {
+			return true;
+		}
+		return false;
+	}
+}
+
+namespace modification
+{
+	TEST_CLASS(assign)
+	{
+		TEST_METHOD(replaces_a_valid_value)
+		{
+			auto p = Percent{ 10 };
+			p.assign(90);
+			Assert::AreEqual(90, p.get());
+		}
+
+		TEST_METHOD(keeps_the_old_value_when_the_new_one_is_rejected)
+		{
+			auto p = Percent{ 10 };
+			Assert::IsTrue(throws_constraint_exception([&] { p.assign(101); }));
+			Assert::AreEqual(10, p.get());
+		}
+
+		TEST_METHOD(writes_through_a_reference)
+		{
+			auto v = std::vector<int>{ 1, 2 };
+			auto a = Ascending_Ref{ v };
+			a.assign(std::vector<int>{ 3, 4, 5 });
+			Assert::AreEqual(std::size_t{ 3 }, v.size());
+
+			Assert::IsTrue(throws_constraint_exception([&] { a.assign(std::vector<int>{ 2, 1 }); }));
+			Assert::AreEqual(5, v.back());
+		}
+	};
+
+	TEST_CLASS(modify)
+	{
+		TEST_METHOD(keeps_a_valid_result)
+		{
+			auto a = Ascending{ { 1, 5, 9 } };
+			a.modify([](std::vector<int>& v) { v.insert(v.begin() + 1, 3); });
+			Assert::IsTrue(a.get() == std::vector<int>{ 1, 3, 5, 9 });
+		}
+
+		TEST_METHOD(discards_a_rejected_result)
+		{
+			auto a = Ascending{ { 1, 5, 9 } };
+			Assert::IsTrue(throws_constraint_exception([&] { a.modify([](std::vector<int>& v) { v[0] = 7; }); }));
+			Assert::IsTrue(a.get() == std::vector<int>{ 1, 5, 9 });
+		}
+
+		TEST_METHOD(leaves_the_referenced_object_alone_on_rejection)
+		{
+			auto v = std::vector<int>{ 1, 2, 3 };
+			auto a = Ascending_Ref{ v };
+			Assert::IsTrue(throws_constraint_exception([&] { a.modify([](std::vector<int>& w) { w.push_back(0); }); }));
+			Assert::AreEqual(std::size_t{ 3 }, v.size());
+
+			a.modify([](std::vector<int>& w) { w.push_back(4); });
+			Assert::AreEqual(4, v.back());
+		}
+	};
+
+	TEST_CLASS(push_back_and_append)
+	{
+		TEST_METHOD(keep_valid_elements)
+		{
+			auto a = Ascending{ { 1, 2 } };
+			a.push_back(2);
+			a.append(std::vector<int>{ 3, 7 });
+			Assert::IsTrue(a.get() == std::vector<int>{ 1, 2, 2, 3, 7 });
+		}
+
+		TEST_METHOD(remove_rejected_elements_again)
+		{
+			auto a = Ascending{ { 1, 2 } };
+			Assert::IsTrue(throws_constraint_exception([&] { a.push_back(0); }));
+			Assert::IsTrue(throws_constraint_exception([&] { a.append(std::vector<int>{ 3, 4, 5, 6, 7, 8, 9 }); }));
+			Assert::IsTrue(a.get() == std::vector<int>{ 1, 2 });
+
+			auto n = Naturals{ { 0, 1 } };
+			Assert::IsTrue(throws_constraint_exception([&] { n.append(std::list<int>{ 2, -3, 4 }); }));
+			Assert::AreEqual(std::size_t{ 2 }, n.get().size());
+		}
+
+		TEST_METHOD(check_only_new_elements_where_the_constraint_allows)
+		{
+			full_checks = 0;
+			auto a = snct::Constrained<std::vector<int>, Counted_Append, Counted_Full>{ { 1, 2, 3 } };
+			Assert::AreEqual(std::size_t{ 2 }, full_checks);
+
+			a.push_back(4);
+			Assert::AreEqual(std::size_t{ 3 }, appended_from);
+			Assert::AreEqual(std::size_t{ 3 }, full_checks);
+
+			a.append(std::vector<int>{ 5, 6 });
+			Assert::AreEqual(std::size_t{ 4 }, appended_from);
+			Assert::AreEqual(std::size_t{ 4 }, full_checks);
+		}
+
+		TEST_METHOD(work_on_strings)
+		{
+			auto t = Text{ "abc" };
+			t.append(std::string{ "def" });
+			t.push_back('g');
+			Assert::AreEqual(std::string{ "abcdefg" }, t.get());
+
+			Assert::IsTrue(throws_constraint_exception([&] { t.push_back('\n'); }));
+			Assert::IsTrue(throws_constraint_exception([&] { t.append(std::string{ "\xC3\xA9" }); }));
+			Assert::AreEqual(std::string{ "abcdefg" }, t.get());
+		}
+	};
+
+	TEST_CLASS(incremental_checks)
+	{
+		TEST_METHOD(Sorted_compares_the_last_old_element)
+		{
+			Assert::IsTrue(snct::Sorted::is_satisfied_after_append(std::vector<int>{ 1, 5, 5, 6 }, 2));
+			Assert::IsFalse(snct::Sorted::is_satisfied_after_append(std::vector<int>{ 1, 5, 4, 6 }, 2));
+			Assert::IsFalse(snct::Sorted::is_satisfied_after_append(std::list<int>{ 9, 5, 4 }, 0));
+		}
+
+		TEST_METHOD(Each_checks_the_new_elements)
+		{
+			using Each = snct::Each<snct::Minimum<0>>;
+			Assert::IsTrue(Each::is_satisfied_after_append(std::vector<int>{ -1, 2, 3 }, 1));
+			Assert::IsFalse(Each::is_satisfied_after_append(std::vector<int>{ 1, 2, -3 }, 1));
+		}
+
+		TEST_METHOD(ValidUtf8_checks_the_new_bytes)
+		{
+			Assert::IsTrue(snct::ValidUtf8::is_satisfied_after_append("\xC3\xA9\xC3\xA9", 2));
+			Assert::IsFalse(snct::ValidUtf8::is_satisfied_after_append("\xC3\xA9\xA9", 2));
+		}
+	};
+}
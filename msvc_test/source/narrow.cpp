@@ -0,0 +1,92 @@
+#include "CppUnitTest.h"
+#include "snct_narrow.hpp"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace narrow
+{
+	using Millis = snct::Constrained<std::int64_t, snct::Minimum<std::int64_t{ 0 }>, snct::Maximum<std::int64_t{ 1000 }>>;
+	using Small = snct::Constrained<int, snct::GreaterThan<-129>, snct::LessThan<128>>;
+	using Unbounded = snct::Constrained<std::int64_t, snct::Minimum<std::int64_t{ 0 }>>;
+	using Ratio = snct::Constrained<double, snct::Minimum<0.0>, snct::Maximum<1.0>>;
+	using Sample = snct::Constrained<double, snct::Minimum<-32768.0>, snct::LessThan<32768.0>>;
+	using FiniteDouble = snct::Constrained<double, snct::Finite>;
+	using FiniteFloat = snct::Constrained<float, snct::Finite>;
+
+	template<typename U, typename T, typename ... C>
+	constexpr bool narrowable(snct::Constrained<T, C...> const*)
+	{
+		return snct::detail::fits_in<U>(snct::detail::interval_of<T, C...>());
+	}
+
+	template<typename U, typename Alias>
+	constexpr bool can_narrow = narrowable<U>(static_cast<Alias const*>(nullptr));
+
+	TEST_CLASS(integers)
+	{
+		TEST_METHOD(narrow_when_the_bounds_fit)
+		{
+			static_assert(can_narrow<std::uint16_t, Millis>);
+			static_assert(can_narrow<std::int8_t, Small>);
+			Assert::AreEqual(std::uint16_t{ 1000 }, snct::narrow_to<std::uint16_t>(Millis{ 1000 }));
+			Assert::AreEqual(std::int8_t{ -128 }, snct::narrow_to<std::int8_t>(Small{ -128 }));
+		}
+
+		TEST_METHOD(do_not_narrow_when_the_bounds_do_not_fit)
+		{
+			static_assert(!can_narrow<std::uint8_t, Millis>);
+			static_assert(!can_narrow<std::uint8_t, Small>);
+			static_assert(!can_narrow<std::uint32_t, Unbounded>);
+			static_assert(can_narrow<std::uint64_t, Unbounded>);
+		}
+
+		TEST_METHOD(convert_to_floating_point_only_when_exact)
+		{
+			static_assert(can_narrow<float, Millis>);
+			static_assert(!can_narrow<float, Unbounded>);
+			Assert::AreEqual(1000.0f, snct::narrow_to<float>(Millis{ 1000 }));
+		}
+
+		TEST_METHOD(work_at_compile_time)
+		{
+			static_assert(snct::narrow_to<std::uint16_t>(Millis{ 7 }) == 7);
+		}
+	};
+
+	TEST_CLASS(floating_point)
+	{
+		TEST_METHOD(narrows_to_integers_by_truncation)
+		{
+			static_assert(can_narrow<std::int16_t, Sample>);
+			static_assert(can_narrow<std::uint8_t, Ratio>);
+			static_assert(!can_narrow<std::int8_t, Sample>);
+			Assert::AreEqual(std::int16_t{ -32768 }, snct::narrow_to<std::int16_t>(Sample{ -32768.0 }));
+			Assert::AreEqual(std::int16_t{ 32767 }, snct::narrow_to<std::int16_t>(Sample{ 32767.9 }));
+		}
+
+		TEST_METHOD(narrows_double_to_float_within_range)
+		{
+			static_assert(can_narrow<float, Ratio>);
+			Assert::AreEqual(0.5f, snct::narrow_to<float>(Ratio{ 0.5 }));
+		}
+
+		TEST_METHOD(narrows_long_double_with_strict_bounds)
+		{
+			using Wide = snct::Constrained<long double, snct::GreaterThan<-1.0L>, snct::LessThan<1.0L>>;
+			static_assert(can_narrow<double, Wide>);
+			static_assert(can_narrow<std::int8_t, Wide>);
+			Assert::AreEqual(0.5, snct::narrow_to<double>(Wide{ 0.5L }));
+		}
+
+		TEST_METHOD(needs_bounds)
+		{
+			static_assert(!can_narrow<float, FiniteDouble>);
+			static_assert(!can_narrow<std::int64_t, FiniteFloat>);
+			static_assert(!can_narrow<float, snct::Constrained<double, snct::Minimum<0.0>>>);
+			static_assert(can_narrow<double, FiniteFloat>);
+		}
+	};
+}
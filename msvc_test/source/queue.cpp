@@ -0,0 +1,192 @@
+#include "CppUnitTest.h"
+#include "snct_queue.hpp"
+#include "snct_constraints.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	using Sample = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<1000>>;
+	using Spsc_Queue = snct::ConstrainedQueue<Sample, 8>;
+	using Mpmc_Queue = snct::ConstrainedQueue<Sample, 8, snct::Queue_Sharing::mpmc>;
+
+	template<typename Queue>
+	std::vector<int> pop_all(Queue& queue)
+	{
+		std::vector<int> result;
+		while (auto const sample = queue.try_pop())
+			result.push_back(sample->get());
+		return result;
+	}
+}
+
+namespace queue
+{
+	template<typename Queue>
+	void pushes_and_pops_in_order()
+	{
+		Queue q;
+		Assert::IsTrue(q.empty());
+		Assert::IsTrue(q.try_push(Sample{ 1 }));
+		Assert::IsTrue(q.try_push(Sample{ 2 }));
+		Assert::AreEqual(std::size_t{ 2 }, q.size());
+		Assert::IsTrue(pop_all(q) == std::vector<int>{ 1, 2 });
+		Assert::IsFalse(q.try_pop().has_value());
+	}
+
+	template<typename Queue>
+	void stops_when_full()
+	{
+		Queue q;
+		std::vector<int> const values{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Assert::AreEqual(std::size_t{ 8 }, q.push(values));
+		Assert::IsFalse(q.try_push(Sample{ 1 }));
+		Assert::AreEqual(std::size_t{ 0 }, q.push(values));
+		Assert::IsTrue(pop_all(q) == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+	}
+
+	template<typename Queue>
+	void bulk_operations_wrap_around()
+	{
+		Queue q;
+		auto out = std::vector<Sample>(5, Sample{ 0 });
+
+		for (int round = 0; round < 10; ++round)
+		{
+			std::vector<int> const values{ round, round + 1, round + 2, round + 3, round + 4 };
+			Assert::AreEqual(std::size_t{ 5 }, q.push(values));
+			Assert::AreEqual(std::size_t{ 5 }, q.pop(out));
+			for (int i = 0; i < 5; ++i)
+				Assert::AreEqual(round + i, out[i].get());
+		}
+	}
+
+	template<typename Queue>
+	void pushes_only_the_valid_prefix()
+	{
+		Queue q;
+		std::vector<int> const values{ 1, 2, -3, 4 };
+		Assert::AreEqual(std::size_t{ 2 }, q.push(values));
+		Assert::IsTrue(pop_all(q) == std::vector<int>{ 1, 2 });
+
+		std::vector<int> const rejected_first{ 2000, 1 };
+		Assert::AreEqual(std::size_t{ 0 }, q.push(rejected_first));
+		Assert::IsTrue(q.empty());
+	}
+
+	template<typename Queue>
+	void pushes_constrained_values_in_bulk()
+	{
+		Queue q;
+		std::vector<Sample> const values{ Sample{ 5 }, Sample{ 6 } };
+		Assert::AreEqual(std::size_t{ 2 }, q.push(std::span<Sample const>{ values }));
+
+		auto out = std::vector<Sample>(4, Sample{ 0 });
+		Assert::AreEqual(std::size_t{ 2 }, q.pop(out));
+		Assert::AreEqual(6, out[1].get());
+	}
+
+	TEST_CLASS(spsc)
+	{
+		TEST_METHOD(pushes_and_pops_in_order) { queue::pushes_and_pops_in_order<Spsc_Queue>(); }
+		TEST_METHOD(stops_when_full) { queue::stops_when_full<Spsc_Queue>(); }
+		TEST_METHOD(bulk_operations_wrap_around) { queue::bulk_operations_wrap_around<Spsc_Queue>(); }
+		TEST_METHOD(pushes_only_the_valid_prefix) { queue::pushes_only_the_valid_prefix<Spsc_Queue>(); }
+		TEST_METHOD(pushes_constrained_values_in_bulk) { queue::pushes_constrained_values_in_bulk<Spsc_Queue>(); }
+
+		TEST_METHOD(hands_every_value_across_threads_in_order)
+		{
+			auto q = std::make_unique<snct::ConstrainedQueue<Sample, 64>>();
+			constexpr int count = 100000;
+
+			std::thread producer([&] {
+				std::vector<int> batch(16);
+				for (int next = 0; next < count;)
+				{
+					std::size_t n = 0;
+					for (; n < batch.size() && next + static_cast<int>(n) < count; ++n)
+						batch[n] = (next + static_cast<int>(n)) % 1001;
+					next += static_cast<int>(q->push(std::span<int const>{ batch.data(), n }));
+				}
+			});
+
+			bool in_order = true;
+			auto out = std::vector<Sample>(16, Sample{ 0 });
+			for (int received = 0; received < count;)
+			{
+				auto const n = q->pop(out);
+				for (std::size_t i = 0; i < n; ++i)
+					in_order = in_order && out[i].get() == (received + static_cast<int>(i)) % 1001;
+				received += static_cast<int>(n);
+			}
+			producer.join();
+
+			Assert::IsTrue(in_order);
+		}
+	};
+
+	TEST_CLASS(mpmc)
+	{
+		TEST_METHOD(pushes_and_pops_in_order) { queue::pushes_and_pops_in_order<Mpmc_Queue>(); }
+		TEST_METHOD(stops_when_full) { queue::stops_when_full<Mpmc_Queue>(); }
+		TEST_METHOD(bulk_operations_wrap_around) { queue::bulk_operations_wrap_around<Mpmc_Queue>(); }
+		TEST_METHOD(pushes_only_the_valid_prefix) { queue::pushes_only_the_valid_prefix<Mpmc_Queue>(); }
+		TEST_METHOD(pushes_constrained_values_in_bulk) { queue::pushes_constrained_values_in_bulk<Mpmc_Queue>(); }
+
+		TEST_METHOD(hands_every_value_to_exactly_one_consumer)
+		{
+			auto q = std::make_unique<snct::ConstrainedQueue<Sample, 64, snct::Queue_Sharing::mpmc>>();
+			constexpr int producers = 4;
+			constexpr int per_producer = 1000;
+
+			std::vector<std::thread> threads;
+			for (int p = 0; p < producers; ++p)
+				threads.emplace_back([&q] {
+					std::vector<int> batch(8, 1);
+					for (int pushed = 0; pushed < per_producer;)
+						pushed += static_cast<int>(q->push(std::span<int const>{ batch.data(), std::min<std::size_t>(batch.size(), per_producer - pushed) }));
+				});
+
+			std::vector<int> received(producers, 0);
+			for (int c = 0; c < producers; ++c)
+				threads.emplace_back([&q, &received, c] {
+					auto out = std::vector<Sample>(4, Sample{ 0 });
+					while (received[c] < per_producer)
+					{
+						auto const n = q->pop(std::span<Sample>{ out.data(), std::min<std::size_t>(out.size(), per_producer - received[c]) });
+						for (std::size_t i = 0; i < n; ++i)
+							received[c] += out[i].get();
+					}
+				});
+
+			for (auto& thread : threads)
+				thread.join();
+
+			for (int c = 0; c < producers; ++c)
+				Assert::AreEqual(per_producer, received[c]);
+			Assert::IsTrue(q->empty());
+		}
+	};
+
+	TEST_CLASS(shared_memory)
+	{
+		TEST_METHOD(works_in_a_raw_buffer)
+		{
+			// Stands in for a shared mapping: constructed once in place, then used through a pointer
+			auto buffer = std::make_unique<std::byte[]>(sizeof(Mpmc_Queue) + alignof(Mpmc_Queue));
+			void* place = buffer.get();
+			std::size_t space = sizeof(Mpmc_Queue) + alignof(Mpmc_Queue);
+			auto* q = new (std::align(alignof(Mpmc_Queue), sizeof(Mpmc_Queue), place, space)) Mpmc_Queue{};
+
+			Assert::IsTrue(q->try_push(Sample{ 42 }));
+			Assert::AreEqual(42, q->try_pop()->get());
+			q->~Mpmc_Queue();
+		}
+	};
+}
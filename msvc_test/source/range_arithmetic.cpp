@@ -0,0 +1,124 @@
+#include "CppUnitTest.h"
+#include "snct_range_arithmetic.hpp"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	template<typename F>
+	bool throws_constraint_exception(F f)
+	{
+		try {
+			f();
+		}
+		catch (snct::Constraint_Exception const&) {
+			return true;
+		}
+		catch (...) {}
+		return false;
+	}
+}
+
+namespace range_arithmetic
+{
+	using Percent = snct::Constrained<int, snct::Minimum<0>, snct::Maximum<100>>;
+	using Offset = snct::Constrained<int, snct::GreaterThan<-11>, snct::LessThan<11>>;
+	using Byte = snct::Constrained<std::uint8_t, snct::Maximum<std::uint8_t{ 200 }>>;
+	using NonNegative = snct::Constrained<int, snct::Minimum<0>>;
+
+	TEST_CLASS(result_types)
+	{
+		TEST_METHOD(carry_the_bounds_of_the_result)
+		{
+			static_assert(std::is_same_v<decltype(Percent{ 1 } + Percent{ 2 }), snct::Constrained<int, snct::Minimum<0>, snct::Maximum<200>>>);
+			static_assert(std::is_same_v<decltype(Percent{ 1 } - Percent{ 2 }), snct::Constrained<int, snct::Minimum<-100>, snct::Maximum<100>>>);
+			static_assert(std::is_same_v<decltype(Percent{ 1 } * Offset{ 2 }), snct::Constrained<int, snct::Minimum<-1000>, snct::Maximum<1000>>>);
+		}
+
+		TEST_METHOD(are_clamped_to_the_underlying_type)
+		{
+			using Sum = decltype(NonNegative{ 1 } + NonNegative{ 2 });
+			static_assert(std::is_same_v<Sum, snct::Constrained<int, snct::Minimum<0>, snct::Maximum<std::numeric_limits<int>::max()>>>);
+
+			using Difference = decltype(Byte{ 1 } - Byte{ 2 });
+			static_assert(std::is_same_v<Difference, snct::Constrained<std::uint8_t, snct::Minimum<std::uint8_t{ 0 }>, snct::Maximum<std::uint8_t{ 200 }>>>);
+		}
+
+		TEST_METHOD(can_be_chained)
+		{
+			auto const total = Percent{ 50 } + Percent{ 60 } + Percent{ 70 };
+			static_assert(std::is_same_v<decltype(total), snct::Constrained<int, snct::Minimum<0>, snct::Maximum<300>> const>);
+			Assert::AreEqual(180, total.get());
+		}
+	};
+
+	TEST_CLASS(proven_results)
+	{
+		TEST_METHOD(are_not_checked)
+		{
+			Percent const a{ 100 }, b{ 100 };
+			static_assert(noexcept(a + b));
+			static_assert(noexcept(a - b));
+			static_assert(noexcept(a * b));
+		}
+
+		TEST_METHOD(have_the_right_values)
+		{
+			Assert::AreEqual(200, (Percent{ 100 } + Percent{ 100 }).get());
+			Assert::AreEqual(-100, (Percent{ 0 } - Percent{ 100 }).get());
+			Assert::AreEqual(-1000, (Percent{ 100 } * Offset{ -10 }).get());
+			Assert::AreEqual(9, (Offset{ -3 } * Offset{ -3 }).get());
+		}
+
+		TEST_METHOD(work_at_compile_time)
+		{
+			static_assert((Percent{ 30 } + Percent{ 12 }).get() == 42);
+		}
+	};
+
+	TEST_CLASS(unproven_results)
+	{
+		TEST_METHOD(are_checked)
+		{
+			NonNegative const a{ 1 };
+			static_assert(!noexcept(a + a));
+			static_assert(!noexcept(Byte{ 1 } - Byte{ 2 }));
+		}
+
+		TEST_METHOD(pass_when_they_fit)
+		{
+			Assert::AreEqual(3, (NonNegative{ 1 } + NonNegative{ 2 }).get());
+			Assert::AreEqual(std::uint8_t{ 150 }, (Byte{ 200 } - Byte{ 50 }).get());
+		}
+
+		TEST_METHOD(throw_on_overflow)
+		{
+			auto const big = NonNegative{ std::numeric_limits<int>::max() };
+			Assert::IsTrue(throws_constraint_exception([&] { (void)(big + NonNegative{ 1 }); }));
+			Assert::IsTrue(throws_constraint_exception([&] { (void)(big * NonNegative{ 2 }); }));
+			Assert::IsTrue(throws_constraint_exception([] { (void)(Byte{ 50 } - Byte{ 51 }); }));
+		}
+	};
+
+	TEST_CLASS(checked_operations)
+	{
+		TEST_METHOD(detect_overflow_at_the_limits)
+		{
+			constexpr auto min = std::numeric_limits<std::int64_t>::min();
+			constexpr auto max = std::numeric_limits<std::int64_t>::max();
+			std::int64_t r = 0;
+
+			Assert::IsTrue(snct::detail::checked_add(max - 1, std::int64_t{ 1 }, r));
+			Assert::IsFalse(snct::detail::checked_add(max, std::int64_t{ 1 }, r));
+			Assert::IsFalse(snct::detail::checked_subtract(min, std::int64_t{ 1 }, r));
+			Assert::IsTrue(snct::detail::checked_subtract(std::int64_t{ -1 }, min, r));
+			Assert::IsFalse(snct::detail::checked_multiply(std::int64_t{ -1 }, min, r));
+			Assert::IsFalse(snct::detail::checked_multiply(min, std::int64_t{ -1 }, r));
+			Assert::IsTrue(snct::detail::checked_multiply(std::int64_t{ 2 }, min / 2, r));
+			Assert::AreEqual(min, r);
+		}
+	};
+}
@@ -0,0 +1,132 @@
+#include "CppUnitTest.h"
+#include "snct_batch.hpp"
+#include "snct_constraints.hpp"
+#include "test_doubles.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace sanitize
+{
+	using Percentage = snct::Constrained<double, snct::Finite, snct::Minimum<0.0>, snct::Maximum<100.0>>;
+	using Reading = snct::Constrained<double, snct::Finite>;
+	using Positive = snct::Constrained<int, snct::GreaterThan<0>, snct::LessThan<10>>;
+
+	template<typename C>
+	concept can_sanitize = requires(typename C::Underlying u) { C::sanitize(u); };
+
+	TEST_CLASS(leaves_unchanged)
+	{
+		TEST_METHOD(values_that_satisfy_the_constraints)
+		{
+			Assert::AreEqual(42.5, Percentage::sanitize(42.5).get());
+			Assert::AreEqual(0.0, Percentage::sanitize(0.0).get());
+			Assert::AreEqual(100.0, Percentage::sanitize(100.0).get());
+			Assert::AreEqual(5, Positive::sanitize(5).get());
+		}
+	};
+
+	TEST_CLASS(clamps)
+	{
+		TEST_METHOD(values_outside_the_bounds_to_the_nearest_bound)
+		{
+			Assert::AreEqual(0.0, Percentage::sanitize(-3.0).get());
+			Assert::AreEqual(100.0, Percentage::sanitize(1000.0).get());
+			Assert::AreEqual(1, Positive::sanitize(-7).get());
+			Assert::AreEqual(9, Positive::sanitize(10).get());
+		}
+
+		TEST_METHOD(infinities_to_the_nearest_bound)
+		{
+			Assert::AreEqual(100.0, Percentage::sanitize(Doubles.at(DD::positive_infinity)).get());
+			Assert::AreEqual(0.0, Percentage::sanitize(Doubles.at(DD::negative_infinity)).get());
+			Assert::AreEqual(Doubles.at(DD::positive_max), Reading::sanitize(Doubles.at(DD::positive_infinity)).get());
+			Assert::AreEqual(Doubles.at(DD::negative_max), Reading::sanitize(Doubles.at(DD::negative_infinity)).get());
+		}
+
+		TEST_METHOD(exclusive_floating_point_bounds_to_the_next_representable_value)
+		{
+			using StrictlyPositive = snct::Constrained<double, snct::GreaterThan<0.0>>;
+			Assert::AreEqual(Doubles.at(DD::positive_denormalized_min), StrictlyPositive::sanitize(-1.0).get());
+		}
+
+		TEST_METHOD(in_the_value_type_when_the_bounds_have_another_type)
+		{
+			using Fraction = snct::Constrained<float, snct::GreaterThan<0.0>, snct::LessThan<1.0>>;
+			Assert::AreEqual(std::nextafter(1.0f, 0.0f), Fraction::sanitize(5.0f).get());
+			Assert::AreEqual(std::numeric_limits<float>::denorm_min(), Fraction::sanitize(-5.0f).get());
+			Assert::IsTrue(Fraction::satisfies_constraints(Fraction::sanitize(5.0f)));
+
+			using Rounded = snct::Constrained<int, snct::Minimum<2.5>, snct::Maximum<7.5>>;
+			Assert::AreEqual(3, Rounded::sanitize(0).get());
+			Assert::AreEqual(7, Rounded::sanitize(100).get());
+
+			using Exclusive = snct::Constrained<int, snct::GreaterThan<2.5>, snct::LessThan<7.5>>;
+			Assert::AreEqual(3, Exclusive::sanitize(0).get());
+			Assert::AreEqual(7, Exclusive::sanitize(100).get());
+
+			using Small = snct::Constrained<signed char, snct::Minimum<-1000>, snct::Maximum<100>>;
+			Assert::AreEqual(100, static_cast<int>(Small::sanitize(static_cast<signed char>(120)).get()));
+			Assert::AreEqual(-5, static_cast<int>(Small::sanitize(static_cast<signed char>(-5)).get()));
+
+			static_assert(Rounded::sanitize(0).get() == 3);
+		}
+
+		TEST_METHOD(long_double_values)
+		{
+			using Ratio = snct::Constrained<long double, snct::Minimum<0.5L>, snct::Maximum<2.0L>>;
+			Assert::IsTrue(Ratio::sanitize(5.0L).get() == 2.0L);
+
+			using Open = snct::Constrained<long double, snct::GreaterThan<0.0L>, snct::LessThan<1.0L>>;
+			Assert::IsTrue(Open::sanitize(5.0L).get() == std::nextafter(1.0L, 0.0L));
+			Assert::IsTrue(Open::sanitize(-5.0L).get() == std::numeric_limits<long double>::denorm_min());
+		}
+	};
+
+	TEST_CLASS(replaces_NaN)
+	{
+		TEST_METHOD(with_zero_when_there_are_no_bounds)
+		{
+			Assert::AreEqual(0.0, Reading::sanitize(Doubles.at(DD::quiet_NaN)).get());
+		}
+
+		TEST_METHOD(with_a_bound_regardless_of_constraint_order)
+		{
+			using BoundsFirst = snct::Constrained<double, snct::Minimum<5.0>, snct::Maximum<10.0>, snct::Finite>;
+			using BoundsLast = snct::Constrained<double, snct::NotNaN, snct::Minimum<5.0>, snct::Maximum<10.0>>;
+
+			Assert::IsTrue(BoundsFirst::satisfies_constraints(BoundsFirst::sanitize(Doubles.at(DD::quiet_NaN))));
+			Assert::IsTrue(BoundsLast::satisfies_constraints(BoundsLast::sanitize(Doubles.at(DD::quiet_NaN))));
+		}
+	};
+
+	TEST_CLASS(is_only_available)
+	{
+		TEST_METHOD(when_every_constraint_can_project)
+		{
+			static_assert(can_sanitize<Percentage>);
+			static_assert(can_sanitize<snct::Constrained<int, snct::AlwaysSatisfied, snct::Satisfied<true>>>);
+			static_assert(!can_sanitize<snct::Constrained<double, snct::Not<0.0>>>);
+			static_assert(!can_sanitize<snct::Constrained<int, snct::Satisfied<false>>>);
+		}
+
+		TEST_METHOD(at_compile_time)
+		{
+			static_assert(Percentage::sanitize(150.0).get() == 100.0);
+		}
+	};
+
+	TEST_CLASS(bulk)
+	{
+		TEST_METHOD(projects_every_value_in_place)
+		{
+			auto values = std::vector<double>{ -1.0, 50.0, Doubles.at(DD::quiet_NaN), Doubles.at(DD::positive_infinity), 101.0 };
+
+			snct::sanitize<Percentage>(values);
+
+			Assert::IsTrue(std::vector<double>{ 0.0, 50.0, 0.0, 100.0, 100.0 } == values);
+		}
+	};
+}
@@ -0,0 +1,97 @@
+#include "CppUnitTest.h"
+#include "snct_sort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	// n random values of Alias between lo and hi, inclusive
+	template<typename Alias, typename T>
+	std::vector<Alias> random_values(std::size_t n, T lo, T hi)
+	{
+		auto engine = std::mt19937_64{ 12345 };
+		auto distribution = std::uniform_int_distribution<T>{ lo, hi };
+		std::vector<Alias> values;
+		for (std::size_t i = 0; i < n; ++i)
+			values.push_back(Alias{ distribution(engine) });
+		return values;
+	}
+
+	template<typename Alias>
+	bool sorts_like_std_sort(std::vector<Alias> values)
+	{
+		std::vector<typename Alias::Underlying> expected(values.begin(), values.end());
+		std::sort(expected.begin(), expected.end());
+
+		snct::sort(values);
+		return std::equal(values.begin(), values.end(), expected.begin(), expected.end(),
+			[](Alias const& a, typename Alias::Underlying b) { return a.get() == b; });
+	}
+}
+
+namespace constrained_sort
+{
+	using Code = snct::Constrained<std::uint32_t, snct::Maximum<4095u>>;
+	using Temperature = snct::Constrained<int, snct::Minimum<-50>, snct::Maximum<60>>;
+	using Id = snct::Constrained<std::int64_t, snct::AlwaysSatisfied>;
+	using Level = snct::Constrained<std::uint8_t, snct::Minimum<std::uint8_t{ 7 }>, snct::Maximum<std::uint8_t{ 7 }>>;
+
+	TEST_CLASS(sort_plan)
+	{
+		TEST_METHOD(uses_the_fewest_radix_passes)
+		{
+			static_assert(snct::detail::Radix_Plan<Code>::passes == 2);
+			static_assert(snct::detail::Radix_Plan<Code>::bits == 6);
+			static_assert(snct::detail::Radix_Plan<Temperature>::passes == 1);
+			static_assert(snct::detail::Radix_Plan<Id>::passes == 6);
+			static_assert(snct::detail::Integer_Range<Level>::size == 1);
+		}
+	};
+
+	TEST_CLASS(sort)
+	{
+		TEST_METHOD(sorts_short_inputs)
+		{
+			Assert::IsTrue(sorts_like_std_sort(random_values<Code>(10, 0u, 4095u)));
+			Assert::IsTrue(sorts_like_std_sort(std::vector<Code>{}));
+		}
+
+		TEST_METHOD(sorts_dense_inputs_by_counting)
+		{
+			Assert::IsTrue(sorts_like_std_sort(random_values<Code>(10000, 0u, 4095u)));
+			Assert::IsTrue(sorts_like_std_sort(random_values<Temperature>(1000, -50, 60)));
+		}
+
+		TEST_METHOD(sorts_sparse_inputs_by_radix)
+		{
+			Assert::IsTrue(sorts_like_std_sort(random_values<Code>(100, 0u, 4095u)));
+			Assert::IsTrue(sorts_like_std_sort(random_values<Id>(5000, INT64_MIN, INT64_MAX)));
+			Assert::IsTrue(sorts_like_std_sort(random_values<Id>(5000, std::int64_t{ -10 }, std::int64_t{ 10 })));
+		}
+
+		TEST_METHOD(sorts_a_single_allowed_value)
+		{
+			Assert::IsTrue(sorts_like_std_sort(std::vector<Level>(100, Level{ 7 })));
+		}
+	};
+
+	TEST_CLASS(histogram)
+	{
+		TEST_METHOD(counts_every_allowed_value)
+		{
+			auto const values = std::vector<Temperature>{ -50, 0, 0, 60, 60, 60 };
+			auto const counts = snct::histogram(values);
+
+			Assert::AreEqual(std::size_t{ 111 }, counts.size());
+			Assert::AreEqual(std::size_t{ 1 }, counts[0]);
+			Assert::AreEqual(std::size_t{ 2 }, counts[50]);
+			Assert::AreEqual(std::size_t{ 3 }, counts[110]);
+			Assert::AreEqual(std::size_t{ 0 }, counts[1]);
+		}
+	};
+}
@@ -0,0 +1,109 @@
+#include "CppUnitTest.h"
+#include "snct_validation_counters.hpp"
+#include "snct_constraints.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <typeinfo>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	struct Even
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t % 2 == 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Even' was violated"; }
+	};
+
+	struct Small
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t < 100; }
+		inline static const char* error_message() noexcept { return "Constraint 'Small' was violated"; }
+	};
+
+	using Counted = snct::Constrained<int, Even, Small>;
+	using CountedByte = snct::Constrained<std::uint8_t, snct::Minimum<std::uint8_t{ 1 }>, snct::Maximum<std::uint8_t{ 9 }>>;
+	using Uncounted = snct::Constrained<int, Even>;
+
+	template<typename Alias, typename Constraint>
+	snct::Validation_Count count_of()
+	{
+		auto const counts = snct::validation_counters();
+		auto const it = std::find_if(counts.begin(), counts.end(), [](snct::Validation_Count const& c) {
+			return *c.alias == typeid(Alias) && *c.constraint == typeid(Constraint);
+		});
+		return it == counts.end() ? snct::Validation_Count{ &typeid(Alias), &typeid(Constraint), nullptr } : *it;
+	}
+}
+
+namespace snct
+{
+	template<>
+	inline constexpr bool counts_validations<Counted> = true;
+
+	template<>
+	inline constexpr bool counts_validations<CountedByte> = true;
+}
+
+namespace validation_counters
+{
+	TEST_CLASS(counters)
+	{
+		TEST_METHOD(count_evaluations_and_failures_per_constraint)
+		{
+			auto const even_before = count_of<Counted, Even>();
+			auto const small_before = count_of<Counted, Small>();
+
+			(void)Counted::factory(2);
+			(void)Counted::factory(3);    // fails Even, so Small is not evaluated
+			(void)Counted::factory(200);  // fails Small
+			Assert::IsTrue(Counted::satisfies_constraints(4));
+
+			auto const even = count_of<Counted, Even>();
+			auto const small = count_of<Counted, Small>();
+			Assert::AreEqual(std::uint64_t{ 4 }, even.evaluations - even_before.evaluations);
+			Assert::AreEqual(std::uint64_t{ 1 }, even.failures - even_before.failures);
+			Assert::AreEqual(std::uint64_t{ 3 }, small.evaluations - small_before.evaluations);
+			Assert::AreEqual(std::uint64_t{ 1 }, small.failures - small_before.failures);
+			Assert::AreEqual(std::string{ "Constraint 'Even' was violated" }, std::string{ even.error_message });
+		}
+
+		TEST_METHOD(count_constructor_failures)
+		{
+			auto const before = count_of<Counted, Small>();
+			try {
+				Counted{ 1000 };
+			}
+			catch (snct::Constraint_Exception const&) {}
+			Assert::AreEqual(std::uint64_t{ 1 }, count_of<Counted, Small>().failures - before.failures);
+		}
+
+		TEST_METHOD(count_each_constraint_instead_of_using_a_validity_table)
+		{
+			auto const before = count_of<CountedByte, snct::Maximum<std::uint8_t{ 9 }>>();
+			Assert::IsFalse(CountedByte::satisfies_constraints(10));
+			Assert::AreEqual(std::uint64_t{ 1 }, count_of<CountedByte, snct::Maximum<std::uint8_t{ 9 }>>().failures - before.failures);
+		}
+
+		TEST_METHOD(keep_counts_from_finished_threads)
+		{
+			auto const before = count_of<Counted, Even>();
+			std::thread{ [] {
+				for (int i = 0; i < 10; ++i)
+					(void)Counted::factory(i);
+			} }.join();
+
+			auto const after = count_of<Counted, Even>();
+			Assert::AreEqual(std::uint64_t{ 10 }, after.evaluations - before.evaluations);
+			Assert::AreEqual(std::uint64_t{ 5 }, after.failures - before.failures);
+		}
+
+		TEST_METHOD(are_off_by_default)
+		{
+			(void)Uncounted::factory(1);
+			Assert::AreEqual(std::uint64_t{ 0 }, count_of<Uncounted, Even>().evaluations);
+		}
+	};
+}
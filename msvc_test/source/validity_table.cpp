@@ -0,0 +1,109 @@
+#include "CppUnitTest.h"
+#include "snct_batch.hpp"
+#include "snct_constraints.hpp"
+#include "test_constraints.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace {
+	struct Even
+	{
+		constexpr static bool is_satisfied(auto t) noexcept { return t % 2 == 0; }
+		inline static const char* error_message() noexcept { return "Even"; }
+	};
+}
+
+namespace validity_table
+{
+	using Byte = snct::Constrained<std::uint8_t, snct::Minimum<std::uint8_t{ 10 }>, snct::Maximum<std::uint8_t{ 200 }>, snct::Not<std::uint8_t{ 100 }>, Even>;
+	using SignedByte = snct::Constrained<std::int8_t, snct::GreaterThan<std::int8_t{ -50 }>, Even>;
+	using Word = snct::Constrained<std::uint16_t, snct::Minimum<std::uint16_t{ 1024 }>, Even>;
+
+	template<typename U, typename ... C>
+	constexpr bool fold(U u) { return (C::is_satisfied(u) && ...); }
+
+	TEST_CLASS(is_tabulatable)
+	{
+		TEST_METHOD(for_small_integers_with_constexpr_constraints)
+		{
+			static_assert(snct::Tabulatable<std::uint8_t, snct::Minimum<std::uint8_t{ 10 }>, Even>);
+			static_assert(snct::Tabulatable<std::int16_t, Even>);
+		}
+
+		TEST_METHOD(not_for_large_or_floating_point_types)
+		{
+			static_assert(!snct::Tabulatable<int, Even>);
+			static_assert(!snct::Tabulatable<double, snct::Finite>);
+		}
+
+		TEST_METHOD(not_for_constraints_with_side_effects)
+		{
+			static_assert(!snct::Tabulatable<char, ToggleConstraint_Satisfied>);
+		}
+	};
+
+	TEST_CLASS(agrees_with_the_constraints)
+	{
+		TEST_METHOD(for_every_unsigned_byte)
+		{
+			constexpr auto table = snct::Validity_Table<std::uint8_t, snct::Minimum<std::uint8_t{ 10 }>, snct::Maximum<std::uint8_t{ 200 }>, snct::Not<std::uint8_t{ 100 }>, Even>{};
+			for (int i = 0; i < 256; ++i)
+			{
+				auto const u = static_cast<std::uint8_t>(i);
+				bool const expected = fold<std::uint8_t, snct::Minimum<std::uint8_t{ 10 }>, snct::Maximum<std::uint8_t{ 200 }>, snct::Not<std::uint8_t{ 100 }>, Even>(u);
+				Assert::AreEqual(expected, table.test(u));
+				Assert::AreEqual(expected, Byte::satisfies_constraints(u));
+				Assert::AreEqual(expected, Byte::factory(u).has_value());
+			}
+		}
+
+		TEST_METHOD(for_every_signed_byte)
+		{
+			for (int i = -128; i < 128; ++i)
+			{
+				auto const s = static_cast<std::int8_t>(i);
+				Assert::AreEqual(i > -50 && i % 2 == 0, SignedByte::satisfies_constraints(s));
+			}
+		}
+
+		TEST_METHOD(for_every_16_bit_value_in_a_batch)
+		{
+			auto in = std::vector<std::uint16_t>(65536);
+			for (std::size_t i = 0; i < in.size(); ++i)
+				in[i] = static_cast<std::uint16_t>(i);
+
+			auto const result = std::make_unique<bool[]>(in.size());
+			auto const count = snct::check_valid<Word>(in, std::span<bool>{ result.get(), in.size() });
+
+			Assert::AreEqual(std::size_t{ (65536 - 1024) / 2 }, count);
+			for (std::size_t i = 0; i < in.size(); ++i)
+				Assert::AreEqual(i >= 1024 && i % 2 == 0, result[i]);
+		}
+	};
+
+	TEST_CLASS(ctor)
+	{
+		TEST_METHOD(still_reports_the_first_violated_constraint)
+		{
+			const char* message = nullptr;
+			try {
+				Byte{ std::uint8_t{ 100 } };
+			}
+			catch (snct::Constraint_Exception const& e) {
+				message = e.error_message();
+			}
+
+			Assert::AreEqual(snct::Not<std::uint8_t{ 100 }>::error_message(), message);
+		}
+
+		TEST_METHOD(works_at_compile_time)
+		{
+			constexpr auto b = Byte{ std::uint8_t{ 12 } };
+			static_assert(b.get() == 12);
+		}
+	};
+}
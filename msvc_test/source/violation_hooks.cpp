@@ -0,0 +1,171 @@
+#include "CppUnitTest.h"
+#include "snct_violation_hooks.hpp"
+#include <atomic>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	struct Positive
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t > 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Positive' was violated"; }
+	};
+
+	struct Odd
+	{
+		constexpr static bool is_satisfied(int t) noexcept { return t % 2 != 0; }
+		inline static const char* error_message() noexcept { return "Constraint 'Odd' was violated"; }
+	};
+
+	using Hooked = snct::Constrained<int, Positive, Odd>;
+	using Unhooked = snct::Constrained<int, Positive>;
+
+	std::atomic<int> calls{ 0 };
+	snct::Violation last{};
+
+	void record(snct::Violation const& v) noexcept
+	{
+		last = v;
+		++calls;
+	}
+
+	void count(snct::Violation const&) noexcept
+	{
+		++calls;
+	}
+
+	constexpr auto unlimited = snct::Violation_Hook_Limits{ 1.0, 0.0, 1'000'000 };
+
+	// Installs a hook with the given limits and uninstalls it again
+	template<snct::Violation_Hook_Limits limits>
+	struct Scoped_Hook
+	{
+		explicit Scoped_Hook(snct::Violation_Hook hook = record) { calls = 0; snct::set_violation_hook<limits>(hook); }
+		~Scoped_Hook() { snct::set_violation_hook(nullptr); }
+	};
+}
+
+namespace snct
+{
+	template<>
+	inline constexpr bool calls_violation_hooks<Hooked> = true;
+}
+
+namespace violation_hooks
+{
+	TEST_CLASS(set_violation_hook)
+	{
+		TEST_METHOD(passes_the_alias_message_and_call_site)
+		{
+			auto const hook = Scoped_Hook<unlimited>{};
+
+			auto const factory_line = std::source_location::current().line() + 1;
+			(void)Hooked::factory(4);
+			Assert::AreEqual(1, calls.load());
+			Assert::IsTrue(*last.alias == typeid(Hooked));
+			Assert::AreEqual(std::string{ "Constraint 'Odd' was violated" }, std::string{ last.error_message });
+			Assert::AreEqual(factory_line, last.location.line());
+
+			try {
+				Hooked{ -1 };
+			}
+			catch (snct::Constraint_Exception const&) {}
+			Assert::AreEqual(2, calls.load());
+			Assert::AreEqual(std::string{ "Constraint 'Positive' was violated" }, std::string{ last.error_message });
+		}
+
+		TEST_METHOD(is_not_called_for_valid_values)
+		{
+			auto const hook = Scoped_Hook<unlimited>{};
+			(void)Hooked::factory(3);
+			Hooked{ 5 };
+			Assert::AreEqual(0, calls.load());
+		}
+
+		TEST_METHOD(can_be_removed)
+		{
+			{
+				auto const hook = Scoped_Hook<unlimited>{};
+			}
+			Assert::IsTrue(snct::violation_hook() == nullptr);
+			(void)Hooked::factory(-1);
+			Assert::AreEqual(0, calls.load());
+		}
+
+		TEST_METHOD(is_off_by_default)
+		{
+			auto const hook = Scoped_Hook<unlimited>{};
+			(void)Unhooked::factory(-1);
+			Assert::AreEqual(0, calls.load());
+		}
+	};
+
+	TEST_CLASS(limits)
+	{
+		TEST_METHOD(burst_caps_calls_without_refill)
+		{
+			auto const hook = Scoped_Hook<snct::Violation_Hook_Limits{ 1.0, 0.0, 5 }>{};
+			for (int i = 0; i < 100; ++i)
+				(void)Hooked::factory(-i);
+			Assert::AreEqual(5, calls.load());
+		}
+
+		TEST_METHOD(setting_the_hook_refills_the_bucket)
+		{
+			{
+				auto const hook = Scoped_Hook<snct::Violation_Hook_Limits{ 1.0, 0.0, 3 }>{};
+				for (int i = 0; i < 10; ++i)
+					(void)Hooked::factory(0);
+			}
+			auto const hook = Scoped_Hook<snct::Violation_Hook_Limits{ 1.0, 0.0, 3 }>{};
+			for (int i = 0; i < 10; ++i)
+				(void)Hooked::factory(0);
+			Assert::AreEqual(3, calls.load());
+		}
+
+		TEST_METHOD(burst_of_one_passes_one_without_refill)
+		{
+			auto const hook = Scoped_Hook<snct::Violation_Hook_Limits{ 1.0, 0.0, 1 }>{};
+			for (int i = 0; i < 10; ++i)
+				(void)Hooked::factory(0);
+			Assert::AreEqual(1, calls.load());
+		}
+
+		TEST_METHOD(sample_ratio_zero_passes_nothing)
+		{
+			auto const hook = Scoped_Hook<snct::Violation_Hook_Limits{ 0.0, 0.0, 1'000'000 }>{};
+			for (int i = 0; i < 1000; ++i)
+				(void)Hooked::factory(0);
+			Assert::AreEqual(0, calls.load());
+		}
+
+		TEST_METHOD(sample_ratio_passes_roughly_that_share)
+		{
+			auto const hook = Scoped_Hook<snct::Violation_Hook_Limits{ 0.25, 0.0, 1'000'000 }>{};
+			for (int i = 0; i < 10'000; ++i)
+				(void)Hooked::factory(0);
+			Assert::IsTrue(calls > 2'000 && calls < 3'000);
+		}
+
+		TEST_METHOD(burst_is_shared_between_threads)
+		{
+			auto const hook = Scoped_Hook<snct::Violation_Hook_Limits{ 1.0, 0.0, 50 }>{ count };
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+				threads.emplace_back([] {
+					for (int i = 0; i < 100; ++i)
+						(void)Hooked::factory(0);
+				});
+			for (auto& thread : threads)
+				thread.join();
+
+			Assert::AreEqual(50, calls.load());
+		}
+	};
+}
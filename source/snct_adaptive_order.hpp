@@ -0,0 +1,217 @@
+#ifndef SNCT_ADAPTIVE_ORDER_HPP
+#define SNCT_ADAPTIVE_ORDER_HPP
+
+
+/***************************************************************************************************/
+/* Opt-in runtime reordering of constraint checks, so the constraint that rejects most values is    */
+/* checked first. Enable with SNCT_ADAPTIVE_ORDER (see snct::adapts_constraint_order) and include   */
+/* this header wherever such an alias is validated.                                                */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace snct
+{
+	namespace detail
+	{
+		// One validation in sample_period is checked against every constraint, and the order is picked
+		// again after every samples_per_reselect samples
+		inline constexpr std::uint32_t sample_period = 64;
+		inline constexpr std::uint32_t samples_per_reselect = 256;
+
+		constexpr std::size_t factorial(std::size_t n) noexcept
+		{
+			return n == 0 ? 1 : n * factorial(n - 1);
+		}
+
+		// Every order of n constraints, in lexicographic order - so the first is the declaration order
+		template<std::size_t n>
+		constexpr auto all_orders() noexcept
+		{
+			std::array<std::array<std::uint8_t, n>, factorial(n)> orders{};
+			std::array<std::uint8_t, n> order{};
+			std::iota(order.begin(), order.end(), std::uint8_t{ 0 });
+			for (auto& o : orders)
+			{
+				o = order;
+				std::next_permutation(order.begin(), order.end());
+			}
+			return orders;
+		}
+
+
+
+		// Each possible order is compiled into its own short-circuiting check, and an atomic index picks
+		// the one in use. Validation costs one indirect call, plus a full check of every constraint on
+		// the sampled values.
+		template<typename T, typename ... ConstraintTypes>
+		struct Adaptive_Order<Constrained<T, ConstraintTypes...>>
+		{
+			static constexpr std::size_t n = sizeof...(ConstraintTypes);
+			static constexpr auto orders = all_orders<n>();
+
+			// Where to start: the order from the cost and rejection rate hints
+			static constexpr std::uint32_t initial = [] {
+				constexpr auto hinted = evaluation_order<ConstraintTypes...>();
+				return static_cast<std::uint32_t>(std::find_if(orders.begin(), orders.end(), [&](auto const& o) {
+					return std::equal(o.begin(), o.end(), hinted.begin());
+				}) - orders.begin());
+			}();
+
+			static bool satisfies(T t) noexcept;
+
+			// Reorders by the cost hints and the failures sampled so far, lowest cost per failure first,
+			// and halves the counts so older samples fade out
+			static void reselect() noexcept;
+
+			static inline std::atomic<std::uint32_t> current{ initial };  // index into orders
+			static inline std::atomic<bool> pinned{ false };
+
+		private:
+			template<std::size_t i>
+			static bool satisfies_nth(T t) noexcept
+			{
+				return std::tuple_element_t<i, std::tuple<ConstraintTypes...>>::is_satisfied(t);
+			}
+
+			template<std::size_t o>
+			static bool satisfies_in_order(T t) noexcept
+			{
+				return [&]<std::size_t ... i>(std::index_sequence<i...>) {
+					return (satisfies_nth<orders[o][i]>(t) && ...);
+				}(std::make_index_sequence<n>{});
+			}
+
+			// Counted per thread and per alias, so a thread that validates several aliases in turn still
+			// samples each of them one validation in sample_period
+			static bool sample_now() noexcept
+			{
+				thread_local std::uint32_t tick = 0;
+				return (++tick & (sample_period - 1)) == 0;
+			}
+
+			static void sample(T t) noexcept;
+
+			static inline std::array<std::atomic<std::uint32_t>, n> failures{};
+			static inline std::atomic<std::uint32_t> samples{ 0 };
+		};
+	}
+
+
+
+	// The order the constraints of Alias are checked in, as indices into its constraint list
+	template<typename Alias>
+	[[nodiscard]] auto constraint_order() noexcept
+	{
+		using Adaptive = detail::Adaptive_Order<Alias>;
+		auto const& order = Adaptive::orders[Adaptive::current.load(std::memory_order_relaxed)];
+
+		std::array<std::size_t, Adaptive::n> result{};
+		std::copy(order.begin(), order.end(), result.begin());
+		return result;
+	}
+
+	// Fixes the order, for tests and benchmarks, until unpin_constraint_order is called. Returns false,
+	// and changes nothing, if order is not a permutation of 0 .. n - 1.
+	template<typename Alias, std::size_t n>
+	bool pin_constraint_order(std::array<std::size_t, n> const& order) noexcept
+	{
+		using Adaptive = detail::Adaptive_Order<Alias>;
+		static_assert(n == Adaptive::n, "snct::pin_constraint_order: the order must list every constraint of the alias");
+
+		for (std::size_t o = 0; o < Adaptive::orders.size(); ++o)
+		{
+			if (std::equal(order.begin(), order.end(), Adaptive::orders[o].begin()))
+			{
+				Adaptive::pinned.store(true, std::memory_order_relaxed);
+				Adaptive::current.store(static_cast<std::uint32_t>(o), std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename Alias>
+	void unpin_constraint_order() noexcept
+	{
+		detail::Adaptive_Order<Alias>::pinned.store(false, std::memory_order_relaxed);
+	}
+
+	// Picks the order from the samples so far rather than waiting for the next scheduled reselection
+	template<typename Alias>
+	void reselect_constraint_order() noexcept
+	{
+		detail::Adaptive_Order<Alias>::reselect();
+	}
+
+
+
+	namespace detail
+	{
+		template<typename T, typename ... ConstraintTypes>
+		inline bool Adaptive_Order<Constrained<T, ConstraintTypes...>>::satisfies(T t) noexcept
+		{
+			static constexpr auto checks = []<std::size_t ... o>(std::index_sequence<o...>) {
+				return std::array<bool (*)(T) noexcept, sizeof...(o)>{ &satisfies_in_order<o>... };
+			}(std::make_index_sequence<orders.size()>{});
+
+			if (sample_now() && !pinned.load(std::memory_order_relaxed))
+				sample(t);
+
+			return checks[current.load(std::memory_order_relaxed)](t);
+		}
+
+
+
+		template<typename T, typename ... ConstraintTypes>
+		inline void Adaptive_Order<Constrained<T, ConstraintTypes...>>::sample(T t) noexcept
+		{
+			[&]<std::size_t ... i>(std::index_sequence<i...>) {
+				((satisfies_nth<i>(t) ? void(0) : void(failures[i].fetch_add(1, std::memory_order_relaxed))), ...);
+			}(std::make_index_sequence<n>{});
+
+			if ((samples.fetch_add(1, std::memory_order_relaxed) + 1) % samples_per_reselect == 0)
+				reselect();
+		}
+
+
+
+		template<typename T, typename ... ConstraintTypes>
+		inline void Adaptive_Order<Constrained<T, ConstraintTypes...>>::reselect() noexcept
+		{
+			if (pinned.load(std::memory_order_relaxed))
+				return;
+
+			std::array<std::uint32_t, n> counts{};
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				counts[i] = failures[i].load(std::memory_order_relaxed);
+				failures[i].store(counts[i] / 2, std::memory_order_relaxed);
+			}
+
+			constexpr std::array<double, n> cost{ check_cost<ConstraintTypes>()... };
+			std::array<double, n> cost_per_failure{};
+			for (std::size_t i = 0; i < n; ++i)
+				cost_per_failure[i] = counts[i] == 0 ? std::numeric_limits<double>::infinity() : cost[i] / counts[i];
+
+			// Ties, including constraints that have not failed, keep the order from the hints
+			std::array<std::uint8_t, n> order = orders[initial];
+			std::stable_sort(order.begin(), order.end(), [&](std::uint8_t a, std::uint8_t b) { return cost_per_failure[a] < cost_per_failure[b]; });
+
+			auto const found = std::find(orders.begin(), orders.end(), order);
+			current.store(static_cast<std::uint32_t>(found - orders.begin()), std::memory_order_relaxed);
+		}
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,224 @@
+#ifndef SNCT_ATOMIC_HPP
+#define SNCT_ATOMIC_HPP
+
+
+/***************************************************************************************************/
+/* A constrained value shared between threads, e.g. a rate limit or threshold that is tuned while   */
+/* in use. Only values that satisfy every constraint are ever published.                            */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <optional>
+#include <source_location>
+#include <type_traits>
+
+namespace snct
+{
+	namespace detail
+	{
+		// current + arg, or current - arg if subtract, or std::nullopt if an integer result does not fit in T
+		template<typename T>
+		constexpr std::optional<T> checked_step(T current, T arg, bool subtract) noexcept
+		{
+			if constexpr (std::integral<T>)
+			{
+				// Wraps in the unsigned type, which is well defined, and then checks for the wrap
+				using Unsigned = std::make_unsigned_t<T>;
+				auto const a = static_cast<Unsigned>(current);
+				auto const b = static_cast<Unsigned>(arg);
+				T const next = static_cast<T>(subtract ? static_cast<Unsigned>(a - b) : static_cast<Unsigned>(a + b));
+
+				bool const overflowed = (arg > 0) == subtract ? next > current : next < current;
+				if (overflowed && arg != 0)
+					return std::nullopt;
+				return next;
+			}
+			else
+				return subtract ? current - arg : current + arg;
+		}
+
+		inline constexpr const char* atomic_overflow_message = "snct::AtomicConstrained: the result does not fit in the underlying type";
+	}
+
+
+
+	// A std::atomic<T> that only ever holds values satisfying every constraint:
+	//
+	//     using Rate_Limit = snct::AtomicConstrained<int, snct::Minimum<1>, snct::Maximum<10000>>;
+	//
+	// Values go in and come out as Constrained<T, ConstraintTypes...>, so store, exchange and
+	// compare_exchange need no check of their own - a T converts, and is checked, before the operation.
+	// fetch_add and fetch_sub check each result in a compare-and-swap loop, and retry only when another
+	// thread got in between. Lock-free wherever std::atomic<T> is.
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	class AtomicConstrained
+	{
+		static_assert(!std::is_reference_v<T> && std::is_trivially_copyable_v<T>,
+			"snct::AtomicConstrained: the underlying type must be a trivially copyable value type, as for std::atomic");
+
+	public:
+		using Value = Constrained<T, ConstraintTypes...>;
+
+		static constexpr bool is_always_lock_free = std::atomic<T>::is_always_lock_free;
+		[[nodiscard]] bool is_lock_free() const noexcept { return value_.is_lock_free(); }
+
+		AtomicConstrained(Value initial) noexcept : value_{ initial.get() } {}
+		AtomicConstrained(AtomicConstrained const&) = delete;
+		AtomicConstrained& operator=(AtomicConstrained const&) = delete;
+
+		[[nodiscard]] Value load(std::memory_order order = std::memory_order_seq_cst) const noexcept;
+		[[nodiscard]] operator Value() const noexcept { return load(); }
+
+		void store(Value desired, std::memory_order order = std::memory_order_seq_cst) noexcept;
+		Value exchange(Value desired, std::memory_order order = std::memory_order_seq_cst) noexcept;
+
+		// On failure, expected is set to the current value
+		bool compare_exchange_weak(Value& expected, Value desired, std::memory_order order = std::memory_order_seq_cst) noexcept;
+		bool compare_exchange_strong(Value& expected, Value desired, std::memory_order order = std::memory_order_seq_cst) noexcept;
+
+		// Return the previous value. If the result is rejected - or an integer result overflows - the
+		// value is left as it is and Constraint_Exception is thrown.
+		Value fetch_add(T arg, std::memory_order order = std::memory_order_seq_cst, std::source_location location = std::source_location::current())
+			requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>);
+
+		Value fetch_sub(T arg, std::memory_order order = std::memory_order_seq_cst, std::source_location location = std::source_location::current())
+			requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>);
+
+		// As fetch_add and fetch_sub, but return std::nullopt instead of throwing
+		[[nodiscard]] std::optional<Value> try_fetch_add(T arg, std::memory_order order = std::memory_order_seq_cst, std::source_location location = std::source_location::current()) noexcept
+			requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>);
+
+		[[nodiscard]] std::optional<Value> try_fetch_sub(T arg, std::memory_order order = std::memory_order_seq_cst, std::source_location location = std::source_location::current()) noexcept
+			requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>);
+
+	private:
+		// Publishes current +/- arg once validate accepts it, and returns the previous value - or
+		// std::nullopt, with nothing published, as soon as validate rejects a result
+		template<typename Validate>
+		std::optional<Value> update(T arg, bool subtract, std::memory_order order, Validate validate);
+
+		static Value trusted(T t) noexcept { return detail::Trusted::make<Value>(t); }
+
+		std::atomic<T> value_;
+	};
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline auto AtomicConstrained<T, ConstraintTypes...>::load(std::memory_order order) const noexcept -> Value
+	{
+		return trusted(value_.load(order));
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline void AtomicConstrained<T, ConstraintTypes...>::store(Value desired, std::memory_order order) noexcept
+	{
+		value_.store(desired.get(), order);
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline auto AtomicConstrained<T, ConstraintTypes...>::exchange(Value desired, std::memory_order order) noexcept -> Value
+	{
+		return trusted(value_.exchange(desired.get(), order));
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline bool AtomicConstrained<T, ConstraintTypes...>::compare_exchange_weak(Value& expected, Value desired, std::memory_order order) noexcept
+	{
+		T current = expected.get();
+		if (value_.compare_exchange_weak(current, desired.get(), order))
+			return true;
+		expected = trusted(current);
+		return false;
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline bool AtomicConstrained<T, ConstraintTypes...>::compare_exchange_strong(Value& expected, Value desired, std::memory_order order) noexcept
+	{
+		T current = expected.get();
+		if (value_.compare_exchange_strong(current, desired.get(), order))
+			return true;
+		expected = trusted(current);
+		return false;
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline auto AtomicConstrained<T, ConstraintTypes...>::fetch_add(T arg, std::memory_order order, std::source_location location) -> Value
+		requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+	{
+		return *update(arg, false, order, [&](std::optional<T> next) {
+			if (!next)
+				throw Constraint_Exception{ detail::atomic_overflow_message, location };
+			return std::optional<Value>{ Value{ *next, location } };
+		});
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline auto AtomicConstrained<T, ConstraintTypes...>::fetch_sub(T arg, std::memory_order order, std::source_location location) -> Value
+		requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+	{
+		return *update(arg, true, order, [&](std::optional<T> next) {
+			if (!next)
+				throw Constraint_Exception{ detail::atomic_overflow_message, location };
+			return std::optional<Value>{ Value{ *next, location } };
+		});
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline auto AtomicConstrained<T, ConstraintTypes...>::try_fetch_add(T arg, std::memory_order order, std::source_location location) noexcept -> std::optional<Value>
+		requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+	{
+		return update(arg, false, order, [&](std::optional<T> next) {
+			return next ? Value::factory(*next, location) : std::nullopt;
+		});
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	inline auto AtomicConstrained<T, ConstraintTypes...>::try_fetch_sub(T arg, std::memory_order order, std::source_location location) noexcept -> std::optional<Value>
+		requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+	{
+		return update(arg, true, order, [&](std::optional<T> next) {
+			return next ? Value::factory(*next, location) : std::nullopt;
+		});
+	}
+
+
+
+	template<typename T, Constraint<T> ... ConstraintTypes>
+	template<typename Validate>
+	inline auto AtomicConstrained<T, ConstraintTypes...>::update(T arg, bool subtract, std::memory_order order, Validate validate) -> std::optional<Value>
+	{
+		// A failed compare-and-swap reloads current, so each retry checks the result from the newest value
+		T current = value_.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			std::optional<Value> const next = validate(detail::checked_step(current, arg, subtract));
+			if (!next)
+				return std::nullopt;
+
+			if (value_.compare_exchange_weak(current, next->get(), order, std::memory_order_relaxed))
+				return trusted(current);
+		}
+	}
+
+} //namespace
+#endif //header guard
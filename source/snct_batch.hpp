@@ -0,0 +1,203 @@
+#ifndef SNCT_BATCH_HPP
+#define SNCT_BATCH_HPP
+
+
+/***************************************************************************************************/
+/* Operations on whole buffers of values, validated against the constraints of a Constrained alias */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace snct
+{
+
+	struct Partition_Counts
+	{
+		std::size_t valid = 0;
+		std::size_t invalid = 0;
+	};
+
+
+
+	namespace detail
+	{
+		template<typename Alias>
+		struct Batch_Table
+		{
+			static constexpr bool enabled = false;
+		};
+
+		template<typename T, typename ... ConstraintTypes>
+			requires Tabulatable<std::remove_cvref_t<T>, ConstraintTypes...>
+		struct Batch_Table<Constrained<T, ConstraintTypes...>>
+		{
+			static constexpr bool enabled = true;
+			static constexpr auto const& get() noexcept { return validity_table<std::remove_cvref_t<T>, ConstraintTypes...>(); }
+		};
+
+
+
+		// Writes every value to both outputs and only advances the cursor that owns it, so the loop
+		// body has no data-dependent branch. Requires room for in.size() values in each output.
+		template<typename Alias, typename U>
+		constexpr Partition_Counts partition_valid_scalar(std::span<U const> in, U* out_valid, U* out_invalid) noexcept
+		{
+			auto counts = Partition_Counts{};
+
+			for (U const& u : in)
+			{
+				bool const valid = Alias::satisfies_constraints(u);
+				out_valid[counts.valid] = u;
+				out_invalid[counts.invalid] = u;
+				counts.valid += valid;
+				counts.invalid += !valid;
+			}
+
+			return counts;
+		}
+
+
+
+#if defined(__AVX512F__)
+		// Evaluates the constraints into a lane mask, then writes survivors and rejects with
+		// compress-stores. Only 32 and 64 bit arithmetic types are handled here.
+		template<typename Alias, typename U>
+		Partition_Counts partition_valid_avx512(std::span<U const> in, U* out_valid, U* out_invalid) noexcept
+		{
+			constexpr std::size_t lanes = 64 / sizeof(U);
+
+			auto counts = Partition_Counts{};
+			std::size_t i = 0;
+
+			for (; i + lanes <= in.size(); i += lanes)
+			{
+				std::uint32_t mask = 0;
+				for (std::size_t lane = 0; lane < lanes; ++lane)
+					mask |= std::uint32_t{ Alias::satisfies_constraints(in[i + lane]) } << lane;
+
+				auto const valid_mask = static_cast<std::uint16_t>(mask);
+				auto const invalid_mask = static_cast<std::uint16_t>(~mask);
+
+				if constexpr (std::is_same_v<U, double>)
+				{
+					__m512d const v = _mm512_loadu_pd(in.data() + i);
+					_mm512_mask_compressstoreu_pd(out_valid + counts.valid, static_cast<__mmask8>(valid_mask), v);
+					_mm512_mask_compressstoreu_pd(out_invalid + counts.invalid, static_cast<__mmask8>(invalid_mask), v);
+				}
+				else if constexpr (std::is_same_v<U, float>)
+				{
+					__m512 const v = _mm512_loadu_ps(in.data() + i);
+					_mm512_mask_compressstoreu_ps(out_valid + counts.valid, valid_mask, v);
+					_mm512_mask_compressstoreu_ps(out_invalid + counts.invalid, invalid_mask, v);
+				}
+				else if constexpr (sizeof(U) == 8)
+				{
+					__m512i const v = _mm512_loadu_si512(in.data() + i);
+					_mm512_mask_compressstoreu_epi64(out_valid + counts.valid, static_cast<__mmask8>(valid_mask), v);
+					_mm512_mask_compressstoreu_epi64(out_invalid + counts.invalid, static_cast<__mmask8>(invalid_mask), v);
+				}
+				else
+				{
+					__m512i const v = _mm512_loadu_si512(in.data() + i);
+					_mm512_mask_compressstoreu_epi32(out_valid + counts.valid, valid_mask, v);
+					_mm512_mask_compressstoreu_epi32(out_invalid + counts.invalid, invalid_mask, v);
+				}
+
+				auto const n_valid = static_cast<std::size_t>(std::popcount(mask));
+				counts.valid += n_valid;
+				counts.invalid += lanes - n_valid;
+			}
+
+			auto const tail = partition_valid_scalar<Alias>(in.subspan(i), out_valid + counts.valid, out_invalid + counts.invalid);
+			counts.valid += tail.valid;
+			counts.invalid += tail.invalid;
+			return counts;
+		}
+#endif
+	}
+
+
+
+	// Copies every value of in that satisfies the constraints of Alias into out_valid, and every
+	// other value into out_invalid, preserving order. Returns how many values went to each output.
+	//
+	// Each output should have room for in.size() values. If either is shorter, only the longest
+	// prefix of in that is guaranteed to fit is partitioned - check valid + invalid against in.size()
+	template<typename Alias>
+	[[nodiscard]] constexpr Partition_Counts partition_valid(
+		std::span<typename Alias::Underlying const> in,
+		std::span<typename Alias::Underlying> out_valid,
+		std::span<typename Alias::Underlying> out_invalid) noexcept
+	{
+		in = in.first(std::min({ in.size(), out_valid.size(), out_invalid.size() }));
+
+#if defined(__AVX512F__)
+		using U = typename Alias::Underlying;
+		if constexpr (std::is_arithmetic_v<U> && (sizeof(U) == 4 || sizeof(U) == 8))
+		{
+			if (!std::is_constant_evaluated())
+				return detail::partition_valid_avx512<Alias>(in, out_valid.data(), out_invalid.data());
+		}
+#endif
+
+		return detail::partition_valid_scalar<Alias>(in, out_valid.data(), out_invalid.data());
+	}
+
+
+
+	// Writes whether each value of in satisfies the constraints of Alias to the matching element of
+	// out, and returns the number of valid values. Only min(in.size(), out.size()) values are checked.
+	//
+	// For 8 and 16 bit integer types, every check is a lookup into a precomputed Validity_Table.
+	template<typename Alias>
+	constexpr std::size_t check_valid(std::span<typename Alias::Underlying const> in, std::span<bool> out) noexcept
+	{
+		auto const n = std::min(in.size(), out.size());
+		std::size_t valid_count = 0;
+
+		if constexpr (detail::Batch_Table<Alias>::enabled)
+		{
+			auto const& table = detail::Batch_Table<Alias>::get();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				out[i] = table.test(in[i]);
+				valid_count += out[i];
+			}
+		}
+		else
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				out[i] = Alias::satisfies_constraints(in[i]);
+				valid_count += out[i];
+			}
+		}
+
+		return valid_count;
+	}
+
+
+
+	// Replaces every value with Alias::sanitize(value), in place. The projections are selects
+	// rather than branches, so the loop vectorizes to min/max/blend instructions.
+	template<typename Alias>
+		requires requires(typename Alias::Underlying u) { Alias::sanitize(u); }
+	constexpr void sanitize(std::span<typename Alias::Underlying> values) noexcept
+	{
+		for (auto& value : values)
+			value = Alias::sanitize(value).get();
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,379 @@
+#ifndef SNCT_BOUNDS_HPP
+#define SNCT_BOUNDS_HPP
+
+
+/***************************************************************************************************/
+/* The range of values a constraint pack allows, worked out at compile time from Minimum, Maximum,  */
+/* LessThan, GreaterThan and Finite                                                                 */
+/***************************************************************************************************/
+
+#include "snct_constraints.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace snct
+{
+	namespace detail
+	{
+		// Bounds of a set of numbers, as std::intmax_t for integers and long double for floating point
+		// values. A bound that is not known (or does not fit) is taken to be the limit of the type.
+		template<typename Number>
+		struct Interval
+		{
+			Number lo{};
+			Number hi{};
+			bool lo_known = false;
+			bool hi_known = false;
+		};
+
+		template<typename T>
+		using Interval_Number = std::conditional_t<std::floating_point<T>, long double, std::intmax_t>;
+
+
+
+		// std::cmp_less and std::in_range reject bool and character types, so every integer is compared
+		// as a std::intmax_t or std::uintmax_t
+		template<std::integral V>
+		constexpr auto widen(V value) noexcept
+		{
+			if constexpr (std::is_signed_v<V>) return static_cast<std::intmax_t>(value);
+			else return static_cast<std::uintmax_t>(value);
+		}
+
+		template<typename Number, typename V>
+		constexpr void raise_lower_bound(Interval<Number>& i, V value) noexcept
+		{
+			if constexpr (std::integral<Number> && std::integral<V>)
+			{
+				if (std::in_range<Number>(widen(value)) && (!i.lo_known || std::cmp_less(i.lo, widen(value))))
+					i = { static_cast<Number>(value), i.hi, true, i.hi_known };
+			}
+			else if constexpr (std::floating_point<Number> && std::floating_point<V>)
+			{
+				if (!i.lo_known || i.lo < value)
+					i = { static_cast<Number>(value), i.hi, true, i.hi_known };
+			}
+		}
+
+		template<typename Number, typename V>
+		constexpr void lower_upper_bound(Interval<Number>& i, V value) noexcept
+		{
+			if constexpr (std::integral<Number> && std::integral<V>)
+			{
+				if (std::in_range<Number>(widen(value)) && (!i.hi_known || std::cmp_less(widen(value), i.hi)))
+					i = { i.lo, static_cast<Number>(value), i.lo_known, true };
+			}
+			else if constexpr (std::floating_point<Number> && std::floating_point<V>)
+			{
+				if (!i.hi_known || value < i.hi)
+					i = { i.lo, static_cast<Number>(value), i.lo_known, true };
+			}
+		}
+
+		// A limit that could not be worked out leaves the interval as it is
+		template<typename Number, typename V>
+		constexpr void raise_lower_bound(Interval<Number>& i, std::optional<V> value) noexcept
+		{
+			if (value)
+				raise_lower_bound(i, *value);
+		}
+
+		template<typename Number, typename V>
+		constexpr void lower_upper_bound(Interval<Number>& i, std::optional<V> value) noexcept
+		{
+			if (value)
+				lower_upper_bound(i, *value);
+		}
+
+
+
+		template<typename T, typename B>
+		concept Same_Kind = (std::integral<T> && std::integral<B>) || (std::floating_point<T> && std::floating_point<B>);
+
+		// The smallest (lower) or largest T that ConstraintType, with a bound of the other kind than T,
+		// accepts - or std::nullopt where the conversion between the two is not exact.
+		//
+		// A floating point bound compares against the integer converted to the bound's type, exactly as
+		// long as the bound's type has as many digits. An integer bound compares against the floating
+		// point value truncated to the bound's type, so Minimum<0> accepts -0.5 and Maximum<10> accepts
+		// 10.5: the limit is the first floating point value that truncates past the bound, for integers
+		// around the bound that T represents exactly.
+		template<typename ConstraintType, typename T, auto bound, bool lower, bool strict>
+		constexpr std::optional<T> limit_of_other_kind() noexcept
+		{
+			using B = decltype(bound);
+
+			if constexpr (std::integral<T> && !std::same_as<T, bool> && std::floating_point<B>)
+			{
+				if constexpr (std::numeric_limits<T>::digits <= std::numeric_limits<B>::digits)
+					return projection<ConstraintType, T, bound, lower>;
+				else
+					return std::nullopt;
+			}
+			else if constexpr (std::floating_point<T> && std::integral<B> && !std::same_as<B, bool>)
+			{
+				constexpr int exact_digits = std::numeric_limits<T>::digits - 1 < 62 ? std::numeric_limits<T>::digits - 1 : 62;
+				constexpr std::intmax_t exact = std::intmax_t{ 1 } << exact_digits;
+				if constexpr (std::cmp_less_equal(widen(bound), -exact) || std::cmp_greater_equal(widen(bound), exact))
+					return std::nullopt;
+				else
+				{
+					// The least (lower) or greatest integer the truncated value may take
+					constexpr std::intmax_t v = static_cast<std::intmax_t>(bound);
+					constexpr std::intmax_t w = strict ? (lower ? v + 1 : v - 1) : v;
+
+					if constexpr (lower)
+						return w > 0 ? static_cast<T>(w) : next_up(static_cast<T>(w - 1));
+					else
+						return w < 0 ? static_cast<T>(w) : next_down(static_cast<T>(w + 1));
+				}
+			}
+			else
+				return std::nullopt;
+		}
+
+
+
+		// Each Bound narrows an interval to the values its constraint allows for a T. Strict bounds become
+		// inclusive bounds on the next representable value, and bounds of the other kind than T are
+		// converted by limit_of_other_kind.
+		template<typename ConstraintType>
+		struct Bound
+		{
+			static constexpr bool is_bound = false;
+			template<typename T, typename Number> static constexpr void narrow(Interval<Number>&) noexcept {}
+		};
+
+		template<auto value>
+		struct Bound<Minimum<value>>
+		{
+			static constexpr bool is_bound = true;
+			template<typename T, typename Number> static constexpr void narrow(Interval<Number>& i) noexcept
+			{
+				if constexpr (Same_Kind<T, decltype(value)>)
+					raise_lower_bound(i, value);
+				else
+					raise_lower_bound(i, limit_of_other_kind<Minimum<value>, T, value, true, false>());
+			}
+		};
+
+		template<auto value>
+		struct Bound<Maximum<value>>
+		{
+			static constexpr bool is_bound = true;
+			template<typename T, typename Number> static constexpr void narrow(Interval<Number>& i) noexcept
+			{
+				if constexpr (Same_Kind<T, decltype(value)>)
+					lower_upper_bound(i, value);
+				else
+					lower_upper_bound(i, limit_of_other_kind<Maximum<value>, T, value, false, false>());
+			}
+		};
+
+		template<auto value>
+		struct Bound<GreaterThan<value>>
+		{
+			static constexpr bool is_bound = true;
+			template<typename T, typename Number> static constexpr void narrow(Interval<Number>& i) noexcept
+			{
+				if constexpr (!Same_Kind<T, decltype(value)>)
+					raise_lower_bound(i, limit_of_other_kind<GreaterThan<value>, T, value, true, true>());
+				else if constexpr (std::integral<decltype(value)>)
+				{
+					if (std::cmp_less(widen(value), std::numeric_limits<std::intmax_t>::max()))
+						raise_lower_bound(i, static_cast<std::intmax_t>(value) + 1);
+				}
+				else
+					raise_lower_bound(i, just_above(value));
+			}
+		};
+
+		template<auto value>
+		struct Bound<LessThan<value>>
+		{
+			static constexpr bool is_bound = true;
+			template<typename T, typename Number> static constexpr void narrow(Interval<Number>& i) noexcept
+			{
+				if constexpr (!Same_Kind<T, decltype(value)>)
+					lower_upper_bound(i, limit_of_other_kind<LessThan<value>, T, value, false, true>());
+				else if constexpr (std::integral<decltype(value)>)
+				{
+					if (std::cmp_greater(widen(value), std::numeric_limits<std::intmax_t>::min()))
+						lower_upper_bound(i, static_cast<std::intmax_t>(value) - 1);
+				}
+				else
+					lower_upper_bound(i, just_below(value));
+			}
+		};
+
+		template<>
+		struct Bound<Finite>
+		{
+			static constexpr bool is_bound = true;
+			template<typename T, typename Number> static constexpr void narrow(Interval<Number>& i) noexcept
+			{
+				raise_lower_bound(i, std::numeric_limits<T>::lowest());
+				lower_upper_bound(i, std::numeric_limits<T>::max());
+			}
+		};
+
+		template<typename ConstraintType>
+		concept Bound_Constraint = Bound<ConstraintType>::is_bound;
+
+
+
+		// Integers start out bounded by their type. Floating point values can be infinite or NaN, so
+		// they are only bounded by constraints.
+		template<typename T, typename ... ConstraintTypes>
+		constexpr Interval<Interval_Number<T>> interval_of() noexcept
+		{
+			auto i = Interval<Interval_Number<T>>{};
+			if constexpr (std::integral<T>)
+			{
+				raise_lower_bound(i, std::numeric_limits<T>::min());
+				lower_upper_bound(i, std::numeric_limits<T>::max());
+			}
+			(Bound<ConstraintTypes>::template narrow<T>(i), ...);
+			return i;
+		}
+
+
+
+		// The smallest and largest value of an integer type T within the interval
+		template<std::integral T>
+		constexpr T lowest_in(Interval<std::intmax_t> i) noexcept
+		{
+			return i.lo_known && std::cmp_greater(i.lo, widen(std::numeric_limits<T>::min())) ? static_cast<T>(i.lo) : std::numeric_limits<T>::min();
+		}
+
+		template<std::integral T>
+		constexpr T highest_in(Interval<std::intmax_t> i) noexcept
+		{
+			return i.hi_known && std::cmp_less(i.hi, widen(std::numeric_limits<T>::max())) ? static_cast<T>(i.hi) : std::numeric_limits<T>::max();
+		}
+
+
+
+		// Maps the values a Constrained integer alias allows onto 0 .. size - 1, by their offset from
+		// the lowest allowed value
+		template<typename Alias>
+		struct Integer_Range
+		{
+			static constexpr bool enabled = false;
+		};
+
+		template<typename T, typename ... ConstraintTypes>
+			requires std::integral<T> && (!std::same_as<T, bool>)
+		struct Integer_Range<Constrained<T, ConstraintTypes...>>
+		{
+			static constexpr bool enabled = true;
+
+			using Key = std::make_unsigned_t<T>;
+			static constexpr auto interval = interval_of<T, ConstraintTypes...>();
+			static constexpr T lowest = lowest_in<T>(interval);
+			static constexpr T highest = highest_in<T>(interval);
+
+			static constexpr Key key(T t) noexcept { return static_cast<Key>(static_cast<Key>(t) - static_cast<Key>(lowest)); }
+			static constexpr T value(Key k) noexcept { return static_cast<T>(static_cast<Key>(lowest) + k); }
+
+			static constexpr Key max_key = key(highest);
+			static constexpr std::uintmax_t size = std::uintmax_t{ max_key } + 1;  // 0 for a 64 bit type with no bounds
+		};
+
+		template<typename Alias>
+		concept Constrained_Integer = Integer_Range<std::remove_cv_t<Alias>>::enabled;
+	}
+
+
+
+	// The range of values a Constrained arithmetic type can hold, as far as its constraints show.
+	// Constraints other than Minimum, Maximum, LessThan, GreaterThan, Finite and NotNaN are ignored,
+	// so the real range can be narrower. An integer bound on a floating point type, or a floating point
+	// bound on an integer type, is converted where the conversion is exact and ignored otherwise - an
+	// integer bound truncates the value it checks, so Minimum<0> on a double lets -0.5 through.
+	template<typename T>
+	struct Bounds
+	{
+		T lower;            // no value is smaller
+		T upper;            // no value is larger
+		bool lower_bounded; // false if lower is only the limit of T (-infinity for floating point types)
+		bool upper_bounded; // false if upper is only the limit of T (+infinity for floating point types)
+		bool may_be_nan;
+	};
+
+
+
+	namespace detail
+	{
+		template<typename Alias>
+		struct Bounds_Of;
+
+		template<typename T, typename ... ConstraintTypes>
+			requires std::is_arithmetic_v<std::remove_cvref_t<T>>
+		struct Bounds_Of<Constrained<T, ConstraintTypes...>>
+		{
+			using V = std::remove_cvref_t<T>;
+
+			static constexpr Bounds<V> get() noexcept
+			{
+				constexpr auto i = interval_of<V, ConstraintTypes...>();
+
+				if constexpr (std::integral<V>)
+				{
+					constexpr V lower = lowest_in<V>(i);
+					constexpr V upper = highest_in<V>(i);
+					return { lower, upper, lower != std::numeric_limits<V>::min(), upper != std::numeric_limits<V>::max(), false };
+				}
+				else
+				{
+					using Limits = std::numeric_limits<V>;
+					constexpr V below_all = Limits::has_infinity ? -Limits::infinity() : Limits::lowest();
+					constexpr V above_all = Limits::has_infinity ? Limits::infinity() : Limits::max();
+
+					// A NaN fails every comparison, so any bound rules it out
+					constexpr bool excludes_nan = i.lo_known || i.hi_known || (std::same_as<ConstraintTypes, NotNaN> || ...);
+
+					return {
+						i.lo_known ? static_cast<V>(i.lo) : below_all,
+						i.hi_known ? static_cast<V>(i.hi) : above_all,
+						i.lo_known, i.hi_known, !excludes_nan };
+				}
+			}
+		};
+	}
+
+	template<typename Alias>
+	inline constexpr auto bounds_of = detail::Bounds_Of<std::remove_cv_t<Alias>>::get();
+
+} //namespace
+
+
+
+namespace std
+{
+	// lowest() and max() are the bounds from snct::bounds_of, and a constrained floating point type only
+	// has infinities and NaNs if its constraints allow them. Values are returned as the underlying type.
+	template<typename T, typename ... ConstraintTypes>
+		requires std::is_arithmetic_v<T> && std::same_as<T, std::remove_cv_t<T>>
+	class numeric_limits<snct::Constrained<T, ConstraintTypes...>> : public std::numeric_limits<T>
+	{
+		using Base = std::numeric_limits<T>;
+		static constexpr auto bounds = snct::bounds_of<snct::Constrained<T, ConstraintTypes...>>;
+
+	public:
+		static constexpr bool has_infinity = Base::has_infinity && !(bounds.lower_bounded && bounds.upper_bounded);
+		static constexpr bool has_quiet_NaN = Base::has_quiet_NaN && bounds.may_be_nan;
+		static constexpr bool has_signaling_NaN = Base::has_signaling_NaN && bounds.may_be_nan;
+
+		static constexpr T min() noexcept { return Base::is_integer ? bounds.lower : Base::min(); }
+		static constexpr T lowest() noexcept { return bounds.lower; }
+		static constexpr T max() noexcept { return bounds.upper; }
+	};
+
+} //namespace
+#endif //header guard
@@ -6,6 +6,10 @@
 /* Prior to C++23, <cmath> is not constexpr so we need our own versions of some of these functions */
 /***************************************************************************************************/
 
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
 #include <numeric>
 #include <type_traits>
 
@@ -47,5 +51,87 @@ namespace snct
 
 
 
+	namespace detail
+	{
+		// The largest power of two not above a, for a finite a >= std::numeric_limits<F>::min(). Steps by
+		// 2^32 first, so even the exponent range of an 80 or 128 bit long double takes few iterations.
+		template<std::floating_point F>
+		constexpr F binade_of(F a) noexcept
+		{
+			constexpr F big_step = F{ 4294967296.0 };
+			F p = F{ 1 };
+			while (p / big_step >= std::numeric_limits<F>::min() && p / big_step > a)
+				p /= big_step;
+			while (p > a)
+				p /= F{ 2 };
+			while (p <= a / big_step)
+				p *= big_step;
+			while (p <= a / F{ 2 })
+				p *= F{ 2 };
+			return p;
+		}
+
+		// next_up for a floating point type without a 32 or 64 bit representation to count in, such as
+		// an x87 or quadruple precision long double: the spacing of representable values around t is
+		// worked out from the power of two below |t|
+		template<std::floating_point F>
+		constexpr F next_up_by_arithmetic(F t) noexcept
+		{
+			using Limits = std::numeric_limits<F>;
+
+			if (t == Limits::max())
+				return Limits::has_infinity ? Limits::infinity() : t;
+			if (is_negative_infinite(t))
+				return Limits::lowest();
+
+			F const a = t < F{ 0 } ? -t : t;
+			if (a < Limits::min())
+				return t + Limits::denorm_min();  // subnormal values are evenly spaced
+
+			F const p = binade_of(a);
+			F const spacing = p * Limits::epsilon();
+			if (t > F{ 0 })
+				return t + spacing;
+
+			// Stepping towards zero from a power of two enters the binade below, where values are
+			// twice as close - or, below min(), the subnormals
+			if (a == p)
+				return -(a - (p == Limits::min() ? Limits::denorm_min() : spacing / F{ 2 }));
+			return -(a - spacing);
+		}
+	}
+
+
+
+	// The smallest representable value greater than t (t itself for NaN and +infinity)
+	template<std::floating_point F>
+	[[nodiscard]] constexpr F next_up(F t) noexcept
+	{
+		if (is_nan(t) || is_positive_infinite(t))
+			return t;
+		if (t == F{ 0 })
+			return std::numeric_limits<F>::denorm_min();
+
+		if constexpr (std::numeric_limits<F>::is_iec559 && (sizeof(F) == 4 || sizeof(F) == 8))
+		{
+			using Bits = std::conditional_t<sizeof(F) == 4, std::uint32_t, std::uint64_t>;
+			auto const bits = std::bit_cast<Bits>(t);
+			return std::bit_cast<F>(t > F{ 0 } ? Bits(bits + 1) : Bits(bits - 1));
+		}
+		else
+			return detail::next_up_by_arithmetic(t);
+	}
+
+
+
+	// The largest representable value less than t (t itself for NaN and -infinity)
+	template<std::floating_point F>
+	[[nodiscard]] constexpr F next_down(F t) noexcept
+	{
+		return -next_up(-t);
+	}
+
+
+
 } //namespace
 #endif //header guard
\ No newline at end of file
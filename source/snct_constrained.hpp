@@ -1,16 +1,103 @@
 #ifndef SNCT_CONSTRAINED_HPP
 #define SNCT_CONSTRAINED_HPP
 
+#include <array>
+#include <charconv>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <exception>
+#include <iterator>
 #include <optional>
+#include <source_location>
+
+#include "snct_validity_table.hpp"
 
 
 
 namespace snct
 {
 
+    namespace detail
+    {
+        struct Trusted;
+
+        // Defined in snct_validation_counters.hpp
+        template<typename Alias, typename ConstraintType>
+        void count_validation(bool satisfied) noexcept;
+
+        // Defined in snct_failure_log.hpp
+        template<typename Alias>
+        void record_failure(const char* error_message, std::source_location const& location) noexcept;
+
+        // Defined in snct_violation_hooks.hpp
+        template<typename Alias>
+        void call_violation_hook(const char* error_message, std::source_location const& location) noexcept;
+
+        // Defined in snct_adaptive_order.hpp
+        template<typename Alias>
+        struct Adaptive_Order;
+
+        inline constexpr std::size_t max_adaptive_constraints = 5;
+    }
+
+
+
+    // Validation counters (see snct_validation_counters.hpp) are compiled out unless the macro
+    // SNCT_VALIDATION_COUNTERS is defined in every translation unit, or this is specialized to true
+    // for a particular Constrained alias
+#if defined(SNCT_VALIDATION_COUNTERS)
+    template<typename Alias>
+    inline constexpr bool counts_validations = true;
+#else
+    template<typename Alias>
+    inline constexpr bool counts_validations = false;
+#endif
+
+
+
+    // Likewise, failed validations are only written to the failure log (see snct_failure_log.hpp)
+    // if SNCT_FAILURE_LOG is defined, or this is specialized to true for a particular alias
+#if defined(SNCT_FAILURE_LOG)
+    template<typename Alias>
+    inline constexpr bool logs_failures = true;
+#else
+    template<typename Alias>
+    inline constexpr bool logs_failures = false;
+#endif
+
+
+
+    // And the violation hook (see snct_violation_hooks.hpp) is only called if SNCT_VIOLATION_HOOKS is
+    // defined, or this is specialized to true for a particular alias
+#if defined(SNCT_VIOLATION_HOOKS)
+    template<typename Alias>
+    inline constexpr bool calls_violation_hooks = true;
+#else
+    template<typename Alias>
+    inline constexpr bool calls_violation_hooks = false;
+#endif
+
+
+
+    // Constraints are checked in the order they are declared, unless SNCT_ADAPTIVE_ORDER is defined or
+    // this is specialized to true for a particular alias - then the order is picked at runtime from
+    // how often each constraint fails (see snct_adaptive_order.hpp)
+#if defined(SNCT_ADAPTIVE_ORDER)
+    template<typename Alias>
+    inline constexpr bool adapts_constraint_order = true;
+#else
+    template<typename Alias>
+    inline constexpr bool adapts_constraint_order = false;
+#endif
+
+
+
     template<typename ConstraintType, typename ValueType>
     concept Constraint = requires(ValueType v)
     {
@@ -20,9 +107,119 @@ namespace snct
 
 
 
+    // A constraint that can also move any value into its own domain, e.g. by clamping
+    template<typename ConstraintType, typename ValueType>
+    concept Projecting_Constraint = Constraint<ConstraintType, ValueType> && requires(ValueType v)
+    {
+        { ConstraintType::project(v) } noexcept -> std::convertible_to<std::remove_cvref_t<ValueType>>;
+    };
+
+
+
+    // A constraint that can tell the optimizer about its invariant, e.g. with std::assume_aligned
+    template<typename ConstraintType, typename ValueType>
+    concept Assuming_Constraint = Constraint<ConstraintType, ValueType> && requires(ValueType v)
+    {
+        { ConstraintType::assume(v) } noexcept -> std::convertible_to<std::remove_cvref_t<ValueType>>;
+    };
+
+
+
+    // A constraint on a sequence that can recheck it after elements were appended by looking only at
+    // the new ones - the first old_size elements were there before and satisfied the constraint
+    template<typename ConstraintType, typename ValueType>
+    concept Appending_Constraint = Constraint<ConstraintType, ValueType> && requires(ValueType v, std::size_t old_size)
+    {
+        { ConstraintType::is_satisfied_after_append(v, old_size) } noexcept -> std::same_as<bool>;
+    };
+
+
+
+    // Optional hints for the order constraints are checked in. cost is relative to a single comparison
+    // (1 if not given), rejection_rate is the share of values expected to fail (0.5 if not given).
+    template<typename ConstraintType>
+    concept Costed_Constraint = requires { typename std::bool_constant<(static_cast<double>(ConstraintType::cost) >= 0)>; };
+
+    template<typename ConstraintType>
+    concept Selective_Constraint = requires { typename std::bool_constant<(static_cast<double>(ConstraintType::rejection_rate) >= 0)>; };
+
+
+
+    // A constraint that tells values apart by their address (see snct::Memoized) can only be used when
+    // Constrained holds a reference - the address of a copy says nothing about the value
+    template<typename ConstraintType>
+    concept Identity_Constraint = requires { requires ConstraintType::uses_object_identity; };
+
+
+
+    namespace detail
+    {
+        template<typename ... ConstraintTypes>
+        struct Constraint_List {};
+
+        template<typename ConstraintType>
+        constexpr double check_cost() noexcept
+        {
+            if constexpr (Costed_Constraint<ConstraintType>) return static_cast<double>(ConstraintType::cost);
+            else return 1.0;
+        }
+
+        template<typename ConstraintType>
+        constexpr double rejection_rate() noexcept
+        {
+            if constexpr (Selective_Constraint<ConstraintType>) return static_cast<double>(ConstraintType::rejection_rate);
+            else return 0.5;
+        }
+
+        // The expected cost of checking a constraint per value it rejects - checking the constraint
+        // with the lowest first minimizes the expected cost of the whole chain. Constraints that never
+        // reject go last.
+        template<typename ConstraintType>
+        constexpr double check_priority() noexcept
+        {
+            constexpr double rate = rejection_rate<ConstraintType>();
+            return rate > 0 ? check_cost<ConstraintType>() / rate : std::numeric_limits<double>::infinity();
+        }
+
+        // Indices into the pack in the order the constraints are checked. Without hints, or with equal
+        // hints, that is the declaration order.
+        template<typename ... ConstraintTypes>
+        constexpr std::array<std::size_t, sizeof...(ConstraintTypes)> evaluation_order() noexcept
+        {
+            std::array<double, sizeof...(ConstraintTypes)> const priority{ check_priority<ConstraintTypes>()... };
+            std::array<std::size_t, sizeof...(ConstraintTypes)> order{};
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                std::size_t j = i;
+                for (; j > 0 && priority[order[j - 1]] > priority[i]; --j)
+                    order[j] = order[j - 1];
+                order[j] = i;
+            }
+            return order;
+        }
+
+        template<typename Indices, typename ... ConstraintTypes>
+        struct Ordered_Constraints;
+
+        template<std::size_t ... i, typename ... ConstraintTypes>
+        struct Ordered_Constraints<std::index_sequence<i...>, ConstraintTypes...>
+        {
+            static constexpr auto order = evaluation_order<ConstraintTypes...>();
+            using type = Constraint_List<std::tuple_element_t<order[i], std::tuple<ConstraintTypes...>>...>;
+        };
+
+        template<typename ... ConstraintTypes>
+        using Evaluation_Order = typename Ordered_Constraints<std::index_sequence_for<ConstraintTypes...>, ConstraintTypes...>::type;
+    }
+
+
+
     template<typename T, Constraint<T> ... constraint>
     class Constrained
     {
+        static_assert(std::is_reference_v<T> || !(Identity_Constraint<constraint> || ...),
+            "snct::Constrained: constraints that key on object identity need a reference as the underlying type");
+
     public:
     // META
         using Underlying = std::remove_reference_t<T>;
@@ -32,20 +229,116 @@ namespace snct
         // implicit conversion to underlying
         [[nodiscard]] constexpr operator Underlying const & () const { return underlying_; }
     
-        // function call to underlying
-        [[nodiscard]] constexpr Underlying const & get() const { return underlying_; }
+        // function call to underlying - if any constraint is an Assuming_Constraint, get() returns a
+        // copy that carries the constraint's optimizer hints instead of a reference
+        [[nodiscard]] constexpr decltype(auto) get() const;
         //using value = get;
 
+    // VALIDATION
+
+        // True if t satisfies every constraint - no object is constructed
+        [[nodiscard]] static constexpr bool satisfies_constraints(T t) noexcept;
+
     // CONSTRUCTION
 
-        // Factory returns std::nullopt on constraint violation
-        [[nodiscard]] static constexpr std::optional<Constrained> factory(T t) noexcept;
+        // Factory returns std::nullopt on constraint violation. The location defaults to the caller's,
+        // and is only used if the value is rejected.
+        [[nodiscard]] static constexpr std::optional<Constrained> factory(T t, std::source_location location = std::source_location::current()) noexcept;
+
+        // Sanitize projects t into the constrained domain instead of rejecting it. Only available
+        // when every constraint is a Projecting_Constraint.
+        [[nodiscard]] static constexpr Constrained sanitize(T t) noexcept
+            requires (!std::is_reference_v<T> && (Projecting_Constraint<constraint, T> && ...));
 
-        // Constructor will throw Constraint_Exception unless all constraints are satisfied
+        // Constructor will throw Constraint_Exception unless all constraints are satisfied. The
+        // exception carries the location, which defaults to the caller's.
         Constrained() = delete;
-        constexpr Constrained(T t);
-        
+        constexpr Constrained(T t, std::source_location location = std::source_location::current());
+
+    // MODIFICATION
+
+        // Each of these checks the new value before it is kept, and throws Constraint_Exception - with
+        // the value unchanged - if it is rejected. If T is a reference, the referenced object changes.
+
+        // Replaces the value
+        constexpr void assign(Underlying value, std::source_location location = std::source_location::current())
+            requires std::is_move_assignable_v<Underlying>;
+
+        // Calls fn on a copy of the value, and keeps the copy if it satisfies every constraint
+        template<std::invocable<Underlying&> F>
+        constexpr void modify(F&& fn, std::source_location location = std::source_location::current())
+            requires std::is_copy_constructible_v<Underlying> && std::is_move_assignable_v<Underlying>;
+
+        // Appends to a sequence in place, and removes the new elements again if the result is rejected.
+        // An Appending_Constraint only looks at the new elements, the others check the whole sequence.
+        template<typename E>
+        constexpr void push_back(E&& element, std::source_location location = std::source_location::current())
+            requires requires(Underlying& u) { u.push_back(std::forward<E>(element)); u.pop_back(); u.size(); };
+
+        template<typename R>
+        constexpr void append(R&& elements, std::source_location location = std::source_location::current())
+            requires requires(Underlying& u, R& r) { u.insert(u.end(), std::begin(r), std::end(r)); u.erase(u.begin(), u.end()); u.size(); };
+
     private:
+        static constexpr bool has_assumptions = (Assuming_Constraint<constraint, T> || ...);
+
+        // Small integer types with several constraints replace the fold with a single table lookup,
+        // unless each constraint is being counted
+        static constexpr bool uses_validity_table =
+            sizeof...(constraint) > 1 && sizeof(Underlying) == 1 && Tabulatable<std::remove_cv_t<Underlying>, constraint...> &&
+            !counts_validations<Constrained>;
+
+        // Two to five constraints can be reordered at runtime, unless they are tabulated or counted
+        static constexpr bool uses_adaptive_order =
+            adapts_constraint_order<Constrained> && sizeof...(constraint) > 1 && sizeof...(constraint) <= detail::max_adaptive_constraints &&
+            !uses_validity_table && !counts_validations<Constrained>;
+
+        // The constraints in the order they are checked - see Costed_Constraint and Selective_Constraint
+        using Evaluation_Order = detail::Evaluation_Order<constraint...>;
+
+        // Counts the result of one constraint if validation counters are enabled
+        template<typename C>
+        static constexpr bool counted(bool satisfied) noexcept;
+
+        // Evaluates one constraint. The value is passed on as the lvalue it is here, so checking a
+        // copy (see modify) does not make another.
+        template<typename C, typename V>
+        static constexpr bool check(V& t) noexcept { return counted<C>(C::is_satisfied(t) ? true : false); }
+
+        template<typename V, typename ... C>
+        static constexpr bool check_all(V& t, detail::Constraint_List<C...>) noexcept { return (check<C>(t) && ...); }
+
+        // Throws for the first constraint in the list that t fails
+        template<typename V, typename ... C>
+        static constexpr void check_all(V& t, std::source_location const& location, detail::Constraint_List<C...>);
+
+        // The constructor's check
+        template<typename V>
+        static constexpr void validate(V& t, std::source_location const& location);
+
+        // Throws for the first constraint a sequence fails after elements were appended to its first
+        // old_size, calling undo first
+        template<typename Undo, typename ... C>
+        static constexpr void check_appended(Underlying& u, std::size_t old_size, Undo undo, std::source_location const& location, detail::Constraint_List<C...>);
+
+        static constexpr bool reports_failures = logs_failures<Constrained> || calls_violation_hooks<Constrained>;
+
+        // Passes a rejection by constraint C to the failure log and violation hook, if enabled
+        template<typename C>
+        static void report(std::source_location const& location) noexcept;
+
+        // Reports and throws for the constraint C that rejected t
+        template<typename C, typename V>
+        [[noreturn]] static void reject(V const& t, std::source_location const& location);
+
+        // Reports the first constraint t fails - only called once a value has been rejected
+        static constexpr void report_failure(T t, std::source_location const& location) noexcept;
+
+        template<typename ... C>
+        static void report_first_failure(T t, std::source_location const& location, detail::Constraint_List<C...>) noexcept;
+
+        friend struct detail::Trusted;
+
         class Factoryparam {};
         constexpr Constrained(T t, Factoryparam) : underlying_{ t } {};
         T underlying_;
@@ -53,34 +346,348 @@ namespace snct
 
 
 
+    namespace detail
+    {
+        // Wraps a value that the calling code has already proven to satisfy the constraints, e.g. a
+        // loop counter below its bound. Nothing is checked - only for use inside this library.
+        struct Trusted
+        {
+            template<typename Alias>
+            [[nodiscard]] static constexpr Alias make(typename Alias::Underlying t) noexcept
+            {
+                return Alias{ t, typename Alias::Factoryparam{} };
+            }
+        };
+    }
+
+
+
     class Constraint_Exception : public std::exception
     {
     public:
-        Constraint_Exception(const char* error_message) noexcept : error_message_{ error_message } {}
-        const char* what()  const noexcept override { return error_message_; }
+        Constraint_Exception(const char* error_message, std::source_location location = {}) noexcept
+            : error_message_{ error_message }, location_{ location } {}
+
+        // Also keeps a copy of the rejected value for what(), if it is an arithmetic, enum or pointer
+        // value of at most 16 bytes. Nothing is formatted or allocated here.
+        template<typename V>
+        Constraint_Exception(const char* error_message, V const& value, std::source_location location = {}) noexcept;
+
+        // The error message followed by the rejected value, if one was kept. The value is formatted on
+        // the first call, into a buffer inside the exception - so the first call must not race with
+        // another on the same exception object.
+        const char* what() const noexcept override;
+
+        // The constraint's error message alone
+        const char* error_message() const noexcept { return error_message_; }
+
+        // Where the rejected value was passed to the constructor
+        std::source_location const& where() const noexcept { return location_; }
+
     private:
+        using Formatter = char* (*)(std::byte const* value, char* first, char* last) noexcept;
+
+        template<typename V>
+        static constexpr bool keeps = (std::is_arithmetic_v<V> || std::is_enum_v<V> || std::is_pointer_v<V>) && sizeof(V) <= 16;
+
+        // Writes the value stored in bytes as text, returning the end, or nullptr if it does not fit
+        template<typename V>
+        static char* format(std::byte const* bytes, char* first, char* last) noexcept;
+
         const char* error_message_;
+        std::source_location location_;
+        Formatter format_ = nullptr;
+        alignas(16) std::byte value_[16]{};
+        mutable char text_[256]{};  // empty until what() first formats it
     };
 
 
 
+    template<typename V>
+    inline Constraint_Exception::Constraint_Exception(const char* error_message, V const& value, std::source_location location) noexcept
+        : error_message_{ error_message }, location_{ location }
+    {
+        if constexpr (keeps<V>)
+        {
+            std::memcpy(value_, &value, sizeof(V));
+            format_ = &format<V>;
+        }
+    }
+
+
+
+    inline const char* Constraint_Exception::what() const noexcept
+    {
+        if (format_ == nullptr)
+            return error_message_;
+
+        if (text_[0] == '\0')
+        {
+            char* out = text_;
+            char* const last = text_ + sizeof(text_) - 1;
+            auto const append = [&](const char* text) {
+                for (; out != nullptr && *text != '\0'; ++text)
+                    out = out == last ? nullptr : (*out = *text, out + 1);
+            };
+
+            append(error_message_);
+            append(" (value: ");
+            if (out != nullptr)
+                out = format_(value_, out, last);
+            append(")");
+
+            if (out == nullptr)
+            {
+                text_[0] = '\0';
+                return error_message_;
+            }
+            *out = '\0';
+        }
+        return text_;
+    }
+
+
+
+    template<typename V>
+    inline char* Constraint_Exception::format(std::byte const* bytes, char* first, char* last) noexcept
+    {
+        V value;
+        std::memcpy(&value, bytes, sizeof(V));
+
+        auto const copy = [&](const char* text) -> char* {
+            auto const length = std::strlen(text);
+            return static_cast<std::size_t>(last - first) < length ? nullptr : static_cast<char*>(std::memcpy(first, text, length)) + length;
+        };
+        auto const checked = [](std::to_chars_result result) -> char* { return result.ec == std::errc{} ? result.ptr : nullptr; };
+
+        if constexpr (std::same_as<V, bool>)
+            return copy(value ? "true" : "false");
+        else if constexpr (std::is_enum_v<V>)
+            return format<std::underlying_type_t<V>>(bytes, first, last);
+        else if constexpr (std::is_pointer_v<V>)
+        {
+            if (value == nullptr)
+                return copy("nullptr");
+            first = copy("0x");
+            return first == nullptr ? nullptr : checked(std::to_chars(first, last, reinterpret_cast<std::uintptr_t>(value), 16));
+        }
+        else if constexpr (std::integral<V>)
+            return checked(std::to_chars(first, last, static_cast<std::conditional_t<std::is_signed_v<V>, long long, unsigned long long>>(value)));
+        else
+            return checked(std::to_chars(first, last, value));
+    }
+
+
+
     template<typename T, Constraint<T> ... constraint>
-    [[nodiscard]] inline constexpr Constrained<T, constraint ...>::Constrained(T t) : underlying_{ t }
+    [[nodiscard]] inline constexpr Constrained<T, constraint ...>::Constrained(T t, std::source_location location) : underlying_{ t }
     {
-        ((constraint::is_satisfied(t) ? void(0) : throw Constraint_Exception{ constraint::error_message() }), ...);
+        validate(t, location);
     }
 
 
 
     template<typename T, Constraint<T> ... constraint>
-    [[nodiscard]] inline constexpr std::optional<Constrained<T, constraint ...>> Constrained<T, constraint ...>::factory(T t) noexcept
+    inline constexpr void Constrained<T, constraint ...>::assign(Underlying value, std::source_location location)
+        requires std::is_move_assignable_v<Underlying>
     {
-        bool const all_satisfied = ((constraint::is_satisfied(t) ? true : false) && ...);
+        validate(value, location);
+        underlying_ = std::move(value);
+    }
 
-        if (all_satisfied)
-            return Constrained{ t, Factoryparam{} };
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<std::invocable<typename Constrained<T, constraint ...>::Underlying&> F>
+    inline constexpr void Constrained<T, constraint ...>::modify(F&& fn, std::source_location location)
+        requires std::is_copy_constructible_v<Underlying> && std::is_move_assignable_v<Underlying>
+    {
+        Underlying copy = underlying_;
+        std::forward<F>(fn)(copy);
+        validate(copy, location);
+        underlying_ = std::move(copy);
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename E>
+    inline constexpr void Constrained<T, constraint ...>::push_back(E&& element, std::source_location location)
+        requires requires(Underlying& u) { u.push_back(std::forward<E>(element)); u.pop_back(); u.size(); }
+    {
+        Underlying& u = underlying_;
+        auto const old_size = static_cast<std::size_t>(u.size());
+        u.push_back(std::forward<E>(element));
+        check_appended(u, old_size, [&] { u.pop_back(); }, location, Evaluation_Order{});
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename R>
+    inline constexpr void Constrained<T, constraint ...>::append(R&& elements, std::source_location location)
+        requires requires(Underlying& u, R& r) { u.insert(u.end(), std::begin(r), std::end(r)); u.erase(u.begin(), u.end()); u.size(); }
+    {
+        Underlying& u = underlying_;
+        auto const old_size = static_cast<std::size_t>(u.size());
+        u.insert(u.end(), std::begin(elements), std::end(elements));
+        check_appended(u, old_size, [&] { u.erase(std::next(u.begin(), static_cast<std::ptrdiff_t>(old_size)), u.end()); }, location, Evaluation_Order{});
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    [[nodiscard]] inline constexpr decltype(auto) Constrained<T, constraint ...>::get() const
+    {
+        if constexpr (has_assumptions)
+        {
+            auto assume = []<typename C>(C*, Underlying u) noexcept -> Underlying {
+                if constexpr (Assuming_Constraint<C, T>) return C::assume(u);
+                else return u;
+            };
+
+            Underlying u = underlying_;
+            ((u = assume(static_cast<constraint*>(nullptr), u)), ...);
+            return u;
+        }
         else
-            return std::nullopt;
+            return static_cast<Underlying const &>(underlying_);
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    [[nodiscard]] inline constexpr bool Constrained<T, constraint ...>::satisfies_constraints(T t) noexcept
+    {
+        if constexpr (uses_validity_table)
+            return detail::validity_table<std::remove_cv_t<Underlying>, constraint...>().test(t);
+        else if constexpr (uses_adaptive_order)
+        {
+            if (!std::is_constant_evaluated())
+                return detail::Adaptive_Order<Constrained>::satisfies(t);
+            return check_all(t, Evaluation_Order{});
+        }
+        else
+            return check_all(t, Evaluation_Order{});
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename C>
+    [[nodiscard]] inline constexpr bool Constrained<T, constraint ...>::counted(bool satisfied) noexcept
+    {
+        if constexpr (counts_validations<Constrained>)
+        {
+            if (!std::is_constant_evaluated())
+                detail::count_validation<Constrained, C>(satisfied);
+        }
+
+        return satisfied;
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename V, typename ... C>
+    inline constexpr void Constrained<T, constraint ...>::check_all(V& t, std::source_location const& location, detail::Constraint_List<C...>)
+    {
+        ((check<C>(t) ? void(0) : reject<C>(t, location)), ...);
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename V>
+    inline constexpr void Constrained<T, constraint ...>::validate(V& t, std::source_location const& location)
+    {
+        if constexpr (uses_validity_table || uses_adaptive_order)
+        {
+            if (satisfies_constraints(t))
+                return;
+        }
+
+        check_all(t, location, Evaluation_Order{});
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename Undo, typename ... C>
+    inline constexpr void Constrained<T, constraint ...>::check_appended(Underlying& u, std::size_t old_size, Undo undo, std::source_location const& location, detail::Constraint_List<C...>)
+    {
+        auto const satisfied = [&]<typename Checked>(Checked*) {
+            if constexpr (Appending_Constraint<Checked, T>) return counted<Checked>(Checked::is_satisfied_after_append(u, old_size) ? true : false);
+            else return check<Checked>(u);
+        };
+
+        ((satisfied(static_cast<C*>(nullptr)) ? void(0) : (undo(), reject<C>(u, location))), ...);
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename C>
+    inline void Constrained<T, constraint ...>::report(std::source_location const& location) noexcept
+    {
+        if constexpr (logs_failures<Constrained>)
+            detail::record_failure<Constrained>(C::error_message(), location);
+
+        if constexpr (calls_violation_hooks<Constrained>)
+            detail::call_violation_hook<Constrained>(C::error_message(), location);
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename C, typename V>
+    inline void Constrained<T, constraint ...>::reject(V const& t, std::source_location const& location)
+    {
+        report<C>(location);
+        throw Constraint_Exception{ C::error_message(), t, location };
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    inline constexpr void Constrained<T, constraint ...>::report_failure(T t, std::source_location const& location) noexcept
+    {
+        if constexpr (reports_failures)
+        {
+            if (!std::is_constant_evaluated())
+                report_first_failure(t, location, Evaluation_Order{});
+        }
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    template<typename ... C>
+    inline void Constrained<T, constraint ...>::report_first_failure(T t, std::source_location const& location, detail::Constraint_List<C...>) noexcept
+    {
+        (void)((C::is_satisfied(t) ? false : (report<C>(location), true)) || ...);
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    [[nodiscard]] inline constexpr std::optional<Constrained<T, constraint ...>> Constrained<T, constraint ...>::factory(T t, std::source_location location) noexcept
+    {
+        if (satisfies_constraints(t))
+            return Constrained{ t, Factoryparam{} };
+
+        report_failure(t, location);
+        return std::nullopt;
+    }
+
+
+
+    template<typename T, Constraint<T> ... constraint>
+    [[nodiscard]] inline constexpr Constrained<T, constraint ...> Constrained<T, constraint ...>::sanitize(T t) noexcept
+        requires (!std::is_reference_v<T> && (Projecting_Constraint<constraint, T> && ...))
+    {
+        ((t = constraint::project(t)), ...);
+        return Constrained{ t, Factoryparam{} };
     }
 
 
@@ -3,13 +3,268 @@
 
 #include "snct_constrained.hpp"
 #include "snct_constexpr_math.hpp"
+#include "snct_set_lookup.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace snct
 {
+	// A string literal usable as a template argument: Matches<"[a-z]+">
+	template<std::size_t N>
+	struct Fixed_String
+	{
+		char value[N]{};
+
+		constexpr Fixed_String(char const (&s)[N]) noexcept
+		{
+			for (std::size_t i = 0; i < N; ++i)
+				value[i] = s[i];
+		}
+
+		[[nodiscard]] constexpr std::string_view view() const noexcept { return { value, N - 1 }; }
+	};
+
+
+
+	namespace detail
+	{
+		template<typename T>
+		constexpr T just_below(T t) noexcept
+		{
+			if constexpr (std::floating_point<T>) return snct::next_down(t);
+			else return t - 1;
+		}
+
+		template<typename T>
+		constexpr T just_above(T t) noexcept
+		{
+			if constexpr (std::floating_point<T>) return snct::next_up(t);
+			else return t + 1;
+		}
+
+		// Whether bound lies above or below every value of V, comparing exactly for integers
+		template<typename V, typename B>
+		constexpr bool above_range(B bound) noexcept
+		{
+			if constexpr (std::integral<V> && std::integral<B>) return std::cmp_greater(bound, std::numeric_limits<V>::max());
+			else return static_cast<long double>(bound) > static_cast<long double>(std::numeric_limits<V>::max());
+		}
+
+		template<typename V, typename B>
+		constexpr bool below_range(B bound) noexcept
+		{
+			if constexpr (std::integral<V> && std::integral<B>) return std::cmp_less(bound, std::numeric_limits<V>::lowest());
+			else return static_cast<long double>(bound) < static_cast<long double>(std::numeric_limits<V>::lowest());
+		}
+
+		// The projection of a value that ConstraintType rejects, worked out in the value's own type V:
+		// the bound converted to V, then moved one representable value at a time - upward for lower
+		// bounds, downward for upper ones - until ConstraintType accepts it. A bound of another type,
+		// e.g. LessThan<1.0> on a float, can round to a V outside the domain, and this steps back in.
+		template<typename ConstraintType, typename V, typename B>
+		constexpr V nearest_satisfying(B bound, bool upward) noexcept
+		{
+			if constexpr (std::is_arithmetic_v<V> && !std::same_as<V, bool>)
+			{
+				constexpr V highest = std::numeric_limits<V>::max();
+				constexpr V lowest = std::numeric_limits<V>::lowest();
+
+				V candidate = above_range<V>(bound) ? highest : below_range<V>(bound) ? lowest : static_cast<V>(bound);
+				while (!ConstraintType::is_satisfied(candidate) && candidate != (upward ? highest : lowest))
+					candidate = upward ? just_above(candidate) : just_below(candidate);
+				return candidate;
+			}
+			else
+				return bound;
+		}
+
+		// Computed once per constraint and value type, so clamping stays a select
+		template<typename ConstraintType, typename V, auto bound, bool upward>
+		inline constexpr V projection = nearest_satisfying<ConstraintType, V>(bound, upward);
+
+		// |value| as an M, which must be unsigned and at least as wide as value's type
+		template<std::unsigned_integral M, std::integral V>
+		constexpr M magnitude(V value) noexcept
+		{
+			if constexpr (std::is_signed_v<V>) return value < 0 ? static_cast<M>(M{ 0 } - static_cast<M>(value)) : static_cast<M>(value);
+			else return static_cast<M>(value);
+		}
+
+		// Values of another type than the bound are only projected if both are arithmetic
+		template<typename V, typename B>
+		concept Projectable_Onto = std::same_as<V, B> ||
+			(std::is_arithmetic_v<V> && std::is_arithmetic_v<B> && !std::same_as<V, bool> && !std::same_as<B, bool>);
+
+		[[noreturn]] inline void unreachable() noexcept
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			__assume(false);
+#else
+			__builtin_unreachable();
+#endif
+		}
+
+
+
+		// Error messages are put together at compile time, so they can show a constraint's template
+		// arguments and still be constants in read-only data. Integer, bool, enum and string arguments
+		// are written out; other arguments are shown as 'value'.
+		class Message_Builder
+		{
+		public:
+			constexpr void append(const char* text) noexcept
+			{
+				while (*text != '\0' && size_ < capacity)
+					chars_[size_++] = *text++;
+			}
+
+			constexpr void append(std::string_view text) noexcept
+			{
+				for (std::size_t i = 0; i < text.size() && size_ < capacity; ++i)
+					chars_[size_++] = text[i];
+			}
+
+			template<typename V>
+			constexpr void append_argument(V const& value) noexcept
+			{
+				if constexpr (std::same_as<V, bool>)
+					append(value ? "true" : "false");
+				else if constexpr (std::is_enum_v<V>)
+					append_argument(static_cast<std::underlying_type_t<V>>(value));
+				else if constexpr (requires { { value.view() } -> std::same_as<std::string_view>; })
+				{
+					append("\"");
+					append(value.value);
+					append("\"");
+				}
+				else if constexpr (std::integral<V>)
+				{
+					char digits[24]{};
+					std::size_t n = 0;
+					bool const negative = std::is_signed_v<V> && value < V{ 0 };
+					auto magnitude = negative ? std::uintmax_t{ 0 } - static_cast<std::uintmax_t>(value) : static_cast<std::uintmax_t>(value);
+					do {
+						digits[n++] = static_cast<char>('0' + magnitude % 10);
+						magnitude /= 10;
+					} while (magnitude != 0);
+
+					if (negative)
+						append("-");
+					while (n != 0 && size_ < capacity)
+						chars_[size_++] = digits[--n];
+				}
+				else
+					append("value");
+			}
+
+			constexpr std::size_t size() const noexcept { return size_; }
+			constexpr char operator[](std::size_t i) const noexcept { return chars_[i]; }
+			constexpr const char* c_str() const noexcept { return chars_; }
+
+		private:
+			static constexpr std::size_t capacity = 256;
+			char chars_[capacity + 1]{};  // always null-terminated
+			std::size_t size_ = 0;
+		};
+
+		// Long argument lists (OneOf) are cut short after about this many characters
+		inline constexpr std::size_t message_argument_limit = 160;
+
+		template<Fixed_String name, auto ... arguments>
+		consteval Message_Builder build_violation_message() noexcept
+		{
+			Message_Builder m;
+			m.append("Constraint '");
+			m.append(name.value);
+			if constexpr (sizeof...(arguments) > 0)
+			{
+				bool first = true;
+				bool cut = false;
+				auto const add = [&](auto const& argument) {
+					if (cut)
+						return;
+					if (m.size() > message_argument_limit)
+					{
+						m.append(", ...");
+						cut = true;
+						return;
+					}
+					m.append(first ? "<" : ", ");
+					m.append_argument(argument);
+					first = false;
+				};
+				(add(arguments), ...);
+				m.append(">");
+			}
+			m.append("' was violated");
+			return m;
+		}
+
+		// "Constraint 'name<arguments...>' was violated", as a null-terminated array of exactly the right size
+		template<Fixed_String name, auto ... arguments>
+		inline constexpr auto violation_message = [] {
+			constexpr Message_Builder m = build_violation_message<name, arguments...>();
+			std::array<char, m.size() + 1> text{};
+			for (std::size_t i = 0; i < m.size(); ++i)
+				text[i] = m[i];
+			return text;
+		}();
+
+		// "Constraint 'name<inner>' was violated" for a constraint that applies another one, with inner
+		// the name quoted in that constraint's message. Messages are not constant expressions, so this
+		// is put together at run time - into a fixed buffer, without allocating. A message in another
+		// format is appended whole.
+		inline Message_Builder wrapping_violation_message(const char* name, const char* inner_message) noexcept
+		{
+			constexpr std::string_view prefix = "Constraint '";
+			std::string_view const inner{ inner_message };
+			auto const end = inner.find('\'', prefix.size());
+
+			Message_Builder m;
+			m.append(prefix);
+			m.append(name);
+			if (inner.starts_with(prefix) && end != std::string_view::npos)
+			{
+				m.append("<");
+				m.append(inner.substr(prefix.size(), end - prefix.size()));
+				m.append(">' was violated");
+			}
+			else
+			{
+				m.append("' was violated: ");
+				m.append(inner);
+			}
+			return m;
+		}
+	}
+
+	// Projections (see Constrained::sanitize) map NaN to a default and clamp everything else to the
+	// nearest satisfying value. Bounds map NaN to the bound, so they never produce a NaN for a later
+	// constraint to reject, and Finite only moves non-finite values, so the order of the pack does
+	// not matter as long as the constrained domain is non-empty.
+
 	struct Finite
 	{
 		constexpr static bool is_satisfied(std::floating_point auto t) noexcept { return snct::is_finite(t); }
 		inline static const char* error_message() noexcept { return "Constraint 'snct::Finite' was violated."; }
+
+		template<std::floating_point F>
+		constexpr static F project(F t) noexcept
+		{
+			return snct::is_nan(t) ? F{}
+				: snct::is_positive_infinite(t) ? std::numeric_limits<F>::max()
+				: snct::is_negative_infinite(t) ? std::numeric_limits<F>::lowest()
+				: t;
+		}
 	};
 
 	template<auto value>
@@ -17,7 +272,7 @@ namespace snct
 	{
 		using T = decltype(value);
 		constexpr static bool is_satisfied(T const& t) noexcept { return t != value; }
-		inline static const char* error_message() noexcept { return "Constraint 'snct::Not<value>' was violated."; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::Not", value>.data(); }
 	};
 
 	template<>
@@ -25,6 +280,31 @@ namespace snct
 	{
 		constexpr static bool is_satisfied(auto const* const t) noexcept { return t != nullptr; }
 		inline static const char* error_message() noexcept { return "Constraint 'snct::Not<nullptr>' was violated."; }
+
+		// Constrained::get() passes the pointer through here, so the compiler drops later null checks
+		template<typename P>
+		constexpr static P* assume(P* t) noexcept
+		{
+			if (t == nullptr)
+				detail::unreachable();
+			return t;
+		}
+	};
+
+	using NotNull = Not<nullptr>;
+
+
+	// The pointer is a multiple of alignment - not constexpr, since address bits are not available
+	// during constant evaluation
+	template<std::size_t alignment> requires (std::has_single_bit(alignment))
+	struct Aligned
+	{
+		static bool is_satisfied(auto const* const t) noexcept { return reinterpret_cast<std::uintptr_t>(t) % alignment == 0; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::Aligned", alignment>.data(); }
+
+		// Constrained::get() passes the pointer through here, so the compiler can use aligned loads
+		template<typename P>
+		constexpr static P* assume(P* t) noexcept { return std::assume_aligned<alignment>(t); }
 	};
 
 
@@ -32,6 +312,9 @@ namespace snct
 	{
 		constexpr static bool is_satisfied(std::floating_point auto t) noexcept { return !snct::is_nan(t); }
 		inline static const char* error_message() noexcept { return "Constraint 'snct::NotNaN' was violated."; }
+
+		template<std::floating_point F>
+		constexpr static F project(F t) noexcept { return snct::is_nan(t) ? F{} : t; }
 	};
 
 
@@ -40,7 +323,10 @@ namespace snct
 	{
 		using T = decltype(value);
 		constexpr static bool is_satisfied(T const& t) noexcept { return std::less<T>{}(t, value); }
-		inline static const char* error_message() noexcept { return "Constraint 'snct::LessThan<value>' was violated"; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::LessThan", value>.data(); }
+
+		template<detail::Projectable_Onto<T> V> requires std::is_arithmetic_v<T>
+		constexpr static V project(V const& t) noexcept { return is_satisfied(t) ? t : detail::projection<LessThan, V, value, false>; }
 	};
 
 
@@ -49,7 +335,10 @@ namespace snct
 	{
 		using T = decltype(value);
 		constexpr static bool is_satisfied(T const& t) noexcept { return std::greater<T>{}(t, value); }
-		inline static const char* error_message() noexcept { return "Constraint 'snct::GreaterThan<value>' was violated"; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::GreaterThan", value>.data(); }
+
+		template<detail::Projectable_Onto<T> V> requires std::is_arithmetic_v<T>
+		constexpr static V project(V const& t) noexcept { return is_satisfied(t) ? t : detail::projection<GreaterThan, V, value, true>; }
 	};
 
 
@@ -58,7 +347,10 @@ namespace snct
 	{
 		using T = decltype(value);
 		constexpr static bool is_satisfied(T const& t) noexcept { return std::greater_equal<T>{}(t, value); }
-		inline static const char* error_message() noexcept { return "Constraint 'snct::Minimum<value>' was violated"; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::Minimum", value>.data(); }
+
+		template<detail::Projectable_Onto<T> V>
+		constexpr static V project(V const& t) noexcept { return is_satisfied(t) ? t : detail::projection<Minimum, V, value, true>; }
 	};
 
 
@@ -67,20 +359,79 @@ namespace snct
 	{
 		using T = decltype(value);
 		constexpr static bool is_satisfied(T const& t) noexcept { return std::less_equal<T>{}(t, value); }
-		inline static const char* error_message() noexcept { return "Constraint 'snct::Maximum<value>' was violated"; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::Maximum", value>.data(); }
+
+		template<detail::Projectable_Onto<T> V>
+		constexpr static V project(V const& t) noexcept { return is_satisfied(t) ? t : detail::projection<Maximum, V, value, false>; }
+	};
+
+	template<auto first, decltype(first) ... rest>
+	struct OneOf
+	{
+		using T = decltype(first);
+		static constexpr OneOf_Strategy strategy = detail::choose_strategy(std::array{ first, rest... });
+		constexpr static bool is_satisfied(T const& t) noexcept { return detail::Set_Lookup<strategy, first, rest...>::contains(t); }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::OneOf", first, rest...>.data(); }
+		static constexpr double cost = strategy == OneOf_Strategy::binary_search ? std::bit_width(sizeof...(rest) + 1) : 1;
+	};
+
+	struct PowerOfTwo
+	{
+		constexpr static bool is_satisfied(std::integral auto t) noexcept
+		{
+			return t > 0 && std::has_single_bit(static_cast<std::make_unsigned_t<decltype(t)>>(t));
+		}
+		inline static const char* error_message() noexcept { return "Constraint 'snct::PowerOfTwo' was violated"; }
+
+		constexpr static auto assume(std::integral auto t) noexcept
+		{
+			if (!is_satisfied(t))
+				detail::unreachable();
+			return t;
+		}
+	};
+
+
+	template<auto factor> requires (std::integral<decltype(factor)> && factor > 0)
+	struct MultipleOf
+	{
+		// Divides magnitudes in the common type, so a factor that does not fit the value's type - MultipleOf<256>
+		// on a std::uint8_t - is neither narrowed to 0 nor to a negative number
+		constexpr static bool is_satisfied(std::integral auto t) noexcept
+		{
+			using Magnitude = std::make_unsigned_t<std::common_type_t<decltype(t), decltype(factor)>>;
+			return detail::magnitude<Magnitude>(t) % detail::magnitude<Magnitude>(factor) == 0;
+		}
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::MultipleOf", factor>.data(); }
+
+		constexpr static auto assume(std::integral auto t) noexcept
+		{
+			if (!is_satisfied(t))
+				detail::unreachable();
+			return t;
+		}
+	};
+
+
+	struct NotEmpty
+	{
+		constexpr static bool is_satisfied(auto const& t) noexcept requires requires { std::empty(t); } { return !std::empty(t); }
+		inline static const char* error_message() noexcept { return "Constraint 'snct::NotEmpty' was violated"; }
 	};
 
 	template<bool value>
 	struct Satisfied
 	{
 		constexpr static bool is_satisfied(auto const&) noexcept { return value; }
-		inline static const char* error_message() noexcept { return "Constraint 'snct::Satisfied<true/false>' was violated"; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::Satisfied", value>.data(); }
+		constexpr static auto project(auto const& t) noexcept requires value { return t; }
 	};
 
 	struct AlwaysSatisfied
 	{
 		constexpr static bool is_satisfied(auto const&) noexcept { return true; }
 		inline static const char* error_message() noexcept { return "Constraint 'Always_Valid' was violated"; }
+		constexpr static auto project(auto const& t) noexcept { return t; }
 	};
 
 
@@ -0,0 +1,233 @@
+#ifndef SNCT_CONTAINER_CONSTRAINTS_HPP
+#define SNCT_CONTAINER_CONSTRAINTS_HPP
+
+#include "snct_constraints.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+
+namespace snct
+{
+	namespace detail
+	{
+		inline constexpr std::size_t container_chunk = 64;
+
+		// Checks contiguous ranges a chunk at a time without branching inside the chunk, so the inner
+		// loop vectorizes - exits early between chunks
+		template<std::ranges::forward_range R, typename Predicate>
+		constexpr bool all_of_chunked(R const& r, Predicate predicate) noexcept
+		{
+			if constexpr (std::ranges::contiguous_range<R const> && std::ranges::sized_range<R const>)
+			{
+				auto const* data = std::ranges::data(r);
+				auto const n = static_cast<std::size_t>(std::ranges::size(r));
+
+				std::size_t i = 0;
+				for (; i + container_chunk <= n; i += container_chunk)
+				{
+					bool ok = true;
+					for (std::size_t k = 0; k < container_chunk; ++k)
+						ok &= predicate(data[i + k]);
+					if (!ok)
+						return false;
+				}
+
+				bool ok = true;
+				for (; i < n; ++i)
+					ok &= predicate(data[i]);
+				return ok;
+			}
+			else
+			{
+				for (auto const& element : r)
+					if (!predicate(element))
+						return false;
+				return true;
+			}
+		}
+
+		// The elements from index from on - a subrange of a contiguous range is still contiguous, so the
+		// chunked checks still vectorize
+		template<std::ranges::forward_range R>
+		constexpr auto tail(R const& r, std::size_t from) noexcept
+		{
+			auto const first = std::ranges::next(std::ranges::begin(r), static_cast<std::ranges::range_difference_t<R const>>(from), std::ranges::end(r));
+			return std::ranges::subrange(first, std::ranges::end(r));
+		}
+
+		template<std::ranges::forward_range R>
+		constexpr bool is_sorted_chunked(R const& r) noexcept
+		{
+			if constexpr (std::ranges::contiguous_range<R const> && std::ranges::sized_range<R const>)
+			{
+				auto const* data = std::ranges::data(r);
+				auto const n = static_cast<std::size_t>(std::ranges::size(r));
+				if (n < 2)
+					return true;
+
+				std::size_t i = 0;
+				for (; i + container_chunk < n; i += container_chunk)
+				{
+					bool ok = true;
+					for (std::size_t k = 0; k < container_chunk; ++k)
+						ok &= !(data[i + k + 1] < data[i + k]);
+					if (!ok)
+						return false;
+				}
+
+				bool ok = true;
+				for (; i + 1 < n; ++i)
+					ok &= !(data[i + 1] < data[i]);
+				return ok;
+			}
+			else
+				return std::ranges::is_sorted(r);
+		}
+	}
+
+
+
+	template<std::size_t size>
+	struct Size
+	{
+		constexpr static bool is_satisfied(std::ranges::sized_range auto const& t) noexcept { return std::ranges::size(t) == size; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::Size", size>.data(); }
+	};
+
+
+	template<std::size_t size>
+	struct MinSize
+	{
+		constexpr static bool is_satisfied(std::ranges::sized_range auto const& t) noexcept { return std::ranges::size(t) >= size; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::MinSize", size>.data(); }
+	};
+
+
+	template<std::size_t size>
+	struct MaxSize
+	{
+		constexpr static bool is_satisfied(std::ranges::sized_range auto const& t) noexcept { return std::ranges::size(t) <= size; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::MaxSize", size>.data(); }
+	};
+
+
+	// Ascending according to operator<, equal neighbours allowed
+	struct Sorted
+	{
+		constexpr static bool is_satisfied(std::ranges::forward_range auto const& t) noexcept { return detail::is_sorted_chunked(t); }
+		inline static const char* error_message() noexcept { return "Constraint 'snct::Sorted' was violated"; }
+		static constexpr double cost = 8;  // walks the whole range, so size checks go first
+
+		// Only the new elements, and the last old one, need to be compared
+		constexpr static bool is_satisfied_after_append(std::ranges::forward_range auto const& t, std::size_t old_size) noexcept
+		{
+			return detail::is_sorted_chunked(detail::tail(t, old_size == 0 ? 0 : old_size - 1));
+		}
+	};
+
+
+	namespace detail
+	{
+		template<std::ranges::forward_range R>
+		constexpr bool all_pairs_differ(R const& r) noexcept
+		{
+			for (auto i = std::ranges::begin(r); i != std::ranges::end(r); ++i)
+				for (auto j = std::next(i); j != std::ranges::end(r); ++j)
+					if (*i == *j)
+						return false;
+			return true;
+		}
+
+		// Whether a sorted copy of the n elements of r has no two equal neighbours - or std::nullopt
+		// if the elements cannot be copied without throwing, or the copy cannot be allocated
+		template<std::ranges::forward_range R>
+		std::optional<bool> sorted_copy_is_unique(R const& r, std::size_t n) noexcept
+		{
+			using V = std::ranges::range_value_t<R>;
+			if constexpr (std::is_nothrow_default_constructible_v<V> && std::is_nothrow_copy_assignable_v<V>)
+			{
+				std::unique_ptr<V[]> const copy{ new (std::nothrow) V[n] };
+				if (copy == nullptr)
+					return std::nullopt;
+
+				std::ranges::copy(r, copy.get());
+				if constexpr (std::floating_point<V>)
+				{
+					// operator< is no strict weak ordering once NaN is involved, which std::sort needs.
+					// The total order puts -0 next to +0, so equal values still end up side by side.
+					std::sort(copy.get(), copy.get() + n, [](V a, V b) noexcept { return std::strong_order(a, b) < 0; });
+				}
+				else
+					std::sort(copy.get(), copy.get() + n);
+				return std::adjacent_find(copy.get(), copy.get() + n) == copy.get() + n;
+			}
+			else
+				return std::nullopt;
+		}
+	}
+
+
+
+	// No two elements compare equal. Sorted ranges and short ranges are checked in place. Anything
+	// else is checked on a sorted copy, allocated without throwing - and if the elements can throw
+	// when copied, or the allocation fails, or this is evaluated at compile time, by comparing every
+	// pair, which never throws but takes quadratic time. NaN equals nothing, not even another NaN.
+	struct Unique
+	{
+		template<std::ranges::forward_range R>
+		constexpr static bool is_satisfied(R const& t) noexcept
+		{
+			// A NaN makes any floating point range look sorted to operator<, equal values or not
+			constexpr bool may_hold_nan = std::floating_point<std::ranges::range_value_t<R>>;
+			if (detail::is_sorted_chunked(t) && (!may_hold_nan || detail::all_of_chunked(t, [](auto const& element) noexcept { return element == element; })))
+				return std::ranges::adjacent_find(t) == std::ranges::end(t);
+
+			auto const n = static_cast<std::size_t>(std::ranges::distance(t));
+			if (n > detail::container_chunk && !std::is_constant_evaluated())
+			{
+				if (auto const unique = detail::sorted_copy_is_unique(t, n))
+					return *unique;
+			}
+
+			return detail::all_pairs_differ(t);
+		}
+		inline static const char* error_message() noexcept { return "Constraint 'snct::Unique' was violated"; }
+		static constexpr double cost = 32;
+	};
+
+
+	// Every element satisfies constraint
+	template<typename constraint>
+	struct Each
+	{
+		template<std::ranges::forward_range R>
+			requires Constraint<constraint, std::ranges::range_value_t<R>>
+		constexpr static bool is_satisfied(R const& t) noexcept
+		{
+			return detail::all_of_chunked(t, [](auto const& element) noexcept { return constraint::is_satisfied(element); });
+		}
+		inline static const char* error_message() noexcept
+		{
+			static const detail::Message_Builder message = detail::wrapping_violation_message("snct::Each", constraint::error_message());
+			return message.c_str();
+		}
+		static constexpr double cost = 8 * detail::check_cost<constraint>();
+
+		template<std::ranges::forward_range R>
+			requires Constraint<constraint, std::ranges::range_value_t<R>>
+		constexpr static bool is_satisfied_after_append(R const& t, std::size_t old_size) noexcept
+		{
+			return is_satisfied(detail::tail(t, old_size));
+		}
+	};
+}
+
+#endif //header guard
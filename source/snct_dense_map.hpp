@@ -0,0 +1,328 @@
+#ifndef SNCT_DENSE_MAP_HPP
+#define SNCT_DENSE_MAP_HPP
+
+
+/***************************************************************************************************/
+/* A map from constrained integers to values, stored as a flat array with one slot per allowed key  */
+/***************************************************************************************************/
+
+#include "snct_bounds.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace snct
+{
+	namespace detail
+	{
+		inline constexpr std::uintmax_t dense_map_limit = std::uintmax_t{ 1 } << 20;
+	}
+
+
+
+	// Every key the constraints of Key allow has its own slot, found by subtracting the lowest allowed
+	// key - no hashing, no probing and no bounds check. Which slots hold a value is kept in a bitmap,
+	// so iteration visits the entries in key order and skips empty slots 64 at a time.
+	//
+	// Key must be a Constrained integer that allows at most 2^20 values. Memory use is proportional to
+	// the number of allowed keys, not to the number of entries. A moved-from DenseMap can only be
+	// assigned to, cleared or destroyed.
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	class DenseMap
+	{
+		using Range = detail::Integer_Range<Key>;
+		static_assert(Range::size != 0 && Range::size <= detail::dense_map_limit,
+			"snct::DenseMap: the constraints on the key allow too many values for a flat array");
+
+		template<bool is_const>
+		class Iterator;
+
+	public:
+	// META
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		static constexpr size_type capacity = static_cast<size_type>(Range::size);
+
+	// CONSTRUCTION
+		DenseMap();
+		DenseMap(DenseMap const& other);
+		DenseMap(DenseMap&& other) noexcept;
+		DenseMap& operator=(DenseMap const& other);
+		DenseMap& operator=(DenseMap&& other) noexcept;
+		~DenseMap();
+
+	// ACCESS
+		[[nodiscard]] bool contains(Key const& key) const noexcept { return is_occupied(slot_of(key)); }
+		[[nodiscard]] iterator find(Key const& key) noexcept;
+		[[nodiscard]] const_iterator find(Key const& key) const noexcept;
+
+		// Default-constructs the value if the key is not present
+		Value& operator[](Key const& key) requires std::default_initializable<Value>;
+
+		[[nodiscard]] size_type size() const noexcept { return size_; }
+		[[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+	// MODIFICATION
+		// Constructs a value from args if the key is not present. Returns the entry and whether it was inserted.
+		template<typename ... Args>
+		std::pair<iterator, bool> try_emplace(Key const& key, Args&& ... args);
+
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(Key const& key, M&& value);
+
+		// Returns the number of entries removed, 0 or 1
+		size_type erase(Key const& key) noexcept;
+		void clear() noexcept;
+
+	// ITERATION
+		[[nodiscard]] iterator begin() noexcept { return iterator{ this, next_occupied(0) }; }
+		[[nodiscard]] iterator end() noexcept { return iterator{ this, capacity }; }
+		[[nodiscard]] const_iterator begin() const noexcept { return const_iterator{ this, next_occupied(0) }; }
+		[[nodiscard]] const_iterator end() const noexcept { return const_iterator{ this, capacity }; }
+
+	private:
+		struct alignas(Value) Slot
+		{
+			std::byte bytes[sizeof(Value)];
+		};
+
+		static constexpr size_type words = (capacity + 63) / 64;
+
+		static size_type slot_of(Key const& key) noexcept { return static_cast<size_type>(Range::key(key.get())); }
+		static Key key_of(size_type slot) noexcept { return detail::Trusted::make<Key>(Range::value(static_cast<typename Range::Key>(slot))); }
+
+		bool is_occupied(size_type slot) const noexcept { return (occupied_[slot / 64] >> (slot % 64)) & 1u; }
+		Value* value_at(size_type slot) noexcept { return std::launder(reinterpret_cast<Value*>(&slots_[slot])); }
+		Value const* value_at(size_type slot) const noexcept { return std::launder(reinterpret_cast<Value const*>(&slots_[slot])); }
+
+		// The first occupied slot at or after slot, or capacity if there is none
+		size_type next_occupied(size_type slot) const noexcept;
+
+		std::unique_ptr<Slot[]> slots_;
+		std::vector<std::uint64_t> occupied_;
+		size_type size_ = 0;
+	};
+
+
+
+	// Dereferences to a std::pair of the key and a reference to the value
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	template<bool is_const>
+	class DenseMap<Key, Value>::Iterator
+	{
+		using Map = std::conditional_t<is_const, DenseMap const, DenseMap>;
+		using Reference = std::conditional_t<is_const, Value const&, Value&>;
+
+	public:
+		using value_type = std::pair<Key, Reference>;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+		Iterator(Map* map, size_type slot) noexcept : map_{ map }, slot_{ slot } {}
+		operator Iterator<true>() const noexcept requires (!is_const) { return { map_, slot_ }; }
+
+		value_type operator*() const noexcept { return { key_of(slot_), *map_->value_at(slot_) }; }
+		Iterator& operator++() noexcept { slot_ = map_->next_occupied(slot_ + 1); return *this; }
+		Iterator operator++(int) noexcept { auto const old = *this; ++*this; return old; }
+		bool operator==(Iterator const& other) const noexcept { return slot_ == other.slot_; }
+
+	private:
+		Map* map_ = nullptr;
+		size_type slot_ = 0;
+	};
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	DenseMap<Key, Value>::DenseMap()
+		: slots_{ std::make_unique_for_overwrite<Slot[]>(capacity) }, occupied_(words)
+	{}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	DenseMap<Key, Value>::DenseMap(DenseMap const& other) : DenseMap()
+	{
+		for (size_type slot = other.next_occupied(0); slot < capacity; slot = other.next_occupied(slot + 1))
+			try_emplace(key_of(slot), *other.value_at(slot));
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	DenseMap<Key, Value>::DenseMap(DenseMap&& other) noexcept
+		: slots_{ std::move(other.slots_) }, occupied_{ std::move(other.occupied_) }, size_{ std::exchange(other.size_, 0) }
+	{
+		other.occupied_.clear();
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	DenseMap<Key, Value>& DenseMap<Key, Value>::operator=(DenseMap const& other)
+	{
+		if (this != &other)
+			*this = DenseMap{ other };
+		return *this;
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	DenseMap<Key, Value>& DenseMap<Key, Value>::operator=(DenseMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			slots_ = std::move(other.slots_);
+			occupied_ = std::move(other.occupied_);
+			size_ = std::exchange(other.size_, 0);
+			other.occupied_.clear();
+		}
+		return *this;
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	DenseMap<Key, Value>::~DenseMap()
+	{
+		clear();
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	auto DenseMap<Key, Value>::find(Key const& key) noexcept -> iterator
+	{
+		auto const slot = slot_of(key);
+		return iterator{ this, is_occupied(slot) ? slot : capacity };
+	}
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	auto DenseMap<Key, Value>::find(Key const& key) const noexcept -> const_iterator
+	{
+		auto const slot = slot_of(key);
+		return const_iterator{ this, is_occupied(slot) ? slot : capacity };
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	Value& DenseMap<Key, Value>::operator[](Key const& key) requires std::default_initializable<Value>
+	{
+		auto const slot = slot_of(key);
+		if (!is_occupied(slot))
+			try_emplace(key);
+		return *value_at(slot);
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	template<typename ... Args>
+	auto DenseMap<Key, Value>::try_emplace(Key const& key, Args&& ... args) -> std::pair<iterator, bool>
+	{
+		auto const slot = slot_of(key);
+		if (is_occupied(slot))
+			return { iterator{ this, slot }, false };
+
+		std::construct_at(value_at(slot), std::forward<Args>(args)...);
+		occupied_[slot / 64] |= std::uint64_t{ 1 } << (slot % 64);
+		++size_;
+		return { iterator{ this, slot }, true };
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	template<typename M>
+	auto DenseMap<Key, Value>::insert_or_assign(Key const& key, M&& value) -> std::pair<iterator, bool>
+	{
+		auto const slot = slot_of(key);
+		if (!is_occupied(slot))
+			return try_emplace(key, std::forward<M>(value));
+
+		*value_at(slot) = std::forward<M>(value);
+		return { iterator{ this, slot }, false };
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	auto DenseMap<Key, Value>::erase(Key const& key) noexcept -> size_type
+	{
+		auto const slot = slot_of(key);
+		if (!is_occupied(slot))
+			return 0;
+
+		std::destroy_at(value_at(slot));
+		occupied_[slot / 64] &= ~(std::uint64_t{ 1 } << (slot % 64));
+		--size_;
+		return 1;
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	void DenseMap<Key, Value>::clear() noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<Value>)
+		{
+			for (size_type slot = next_occupied(0); slot < capacity; slot = next_occupied(slot + 1))
+				std::destroy_at(value_at(slot));
+		}
+		std::fill(occupied_.begin(), occupied_.end(), std::uint64_t{ 0 });
+		size_ = 0;
+	}
+
+
+
+	template<typename Key, typename Value>
+		requires detail::Constrained_Integer<Key>
+	auto DenseMap<Key, Value>::next_occupied(size_type slot) const noexcept -> size_type
+	{
+		if (slot >= capacity || occupied_.empty())
+			return capacity;
+
+		size_type word = slot / 64;
+		std::uint64_t bits = occupied_[word] & (~std::uint64_t{ 0 } << (slot % 64));
+
+		while (bits == 0)
+		{
+			if (++word == words)
+				return capacity;
+			bits = occupied_[word];
+		}
+		return word * 64 + static_cast<size_type>(std::countr_zero(bits));
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,158 @@
+#ifndef SNCT_FAILURE_LOG_HPP
+#define SNCT_FAILURE_LOG_HPP
+
+
+/***************************************************************************************************/
+/* Opt-in log of rejected values and where they were rejected, kept in a fixed-size lock-free ring. */
+/* Enable with SNCT_FAILURE_LOG (see snct::logs_failures) and include this header in at least one   */
+/* translation unit.                                                                               */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <source_location>
+#include <typeinfo>
+#include <vector>
+
+namespace snct
+{
+	struct Validation_Failure
+	{
+		std::type_info const* alias;    // the Constrained type
+		const char* error_message;      // from the constraint that rejected the value
+		const char* file_name;          // where the value was passed to the constructor or factory
+		const char* function_name;
+		std::uint_least32_t line = 0;
+		std::uint_least32_t column = 0;
+	};
+
+	// Only the most recent failures are kept - older ones are overwritten, whether drained or not
+	inline constexpr std::size_t failure_log_capacity = 1024;
+
+
+
+	namespace detail::failure_log
+	{
+		// A seqlock per slot: sequence is odd while a writer fills the slot, and 2 * (index + 1) once
+		// failure number index is complete. Every field is atomic so readers never race with writers.
+		struct Slot
+		{
+			std::atomic<std::uint64_t> sequence{ 0 };
+			std::atomic<std::type_info const*> alias{ nullptr };
+			std::atomic<const char*> error_message{ nullptr };
+			std::atomic<const char*> file_name{ nullptr };
+			std::atomic<const char*> function_name{ nullptr };
+			std::atomic<std::uint_least32_t> line{ 0 };
+			std::atomic<std::uint_least32_t> column{ 0 };
+		};
+
+		class Ring
+		{
+		public:
+			// Lock-free for any number of writers
+			void push(Validation_Failure const& failure) noexcept;
+
+			// Everything written since the last drain that has not been overwritten yet
+			[[nodiscard]] std::vector<Validation_Failure> drain();
+
+		private:
+			static_assert((failure_log_capacity & (failure_log_capacity - 1)) == 0, "capacity must be a power of two");
+
+			std::array<Slot, failure_log_capacity> slots_;
+			alignas(64) std::atomic<std::uint64_t> next_{ 0 };
+			alignas(64) std::mutex drain_mutex_;
+			std::uint64_t drained_ = 0;
+		};
+
+		inline Ring& ring()
+		{
+			static Ring r;
+			return r;
+		}
+	}
+
+
+
+	// Returns the failures logged since the last call, oldest first
+	[[nodiscard]] inline std::vector<Validation_Failure> drain_failure_log()
+	{
+		return detail::failure_log::ring().drain();
+	}
+
+
+
+	template<typename Alias>
+	void detail::record_failure(const char* error_message, std::source_location const& location) noexcept
+	{
+		failure_log::ring().push(Validation_Failure{
+			&typeid(Alias), error_message, location.file_name(), location.function_name(), location.line(), location.column() });
+	}
+
+
+
+	namespace detail::failure_log
+	{
+		inline void Ring::push(Validation_Failure const& failure) noexcept
+		{
+			std::uint64_t const index = next_.fetch_add(1, std::memory_order_relaxed);
+			Slot& slot = slots_[index % failure_log_capacity];
+
+			slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			slot.alias.store(failure.alias, std::memory_order_relaxed);
+			slot.error_message.store(failure.error_message, std::memory_order_relaxed);
+			slot.file_name.store(failure.file_name, std::memory_order_relaxed);
+			slot.function_name.store(failure.function_name, std::memory_order_relaxed);
+			slot.line.store(failure.line, std::memory_order_relaxed);
+			slot.column.store(failure.column, std::memory_order_relaxed);
+
+			slot.sequence.store(2 * (index + 1), std::memory_order_release);
+		}
+
+
+
+		inline std::vector<Validation_Failure> Ring::drain()
+		{
+			auto const lock = std::scoped_lock{ drain_mutex_ };
+
+			std::uint64_t const end = next_.load(std::memory_order_acquire);
+			std::uint64_t const begin = end - drained_ > failure_log_capacity ? end - failure_log_capacity : drained_;
+
+			std::vector<Validation_Failure> failures;
+			failures.reserve(static_cast<std::size_t>(end - begin));
+
+			for (std::uint64_t index = begin; index < end; ++index)
+			{
+				Slot const& slot = slots_[index % failure_log_capacity];
+
+				// Skips slots that are still being written, or were overwritten by a newer failure
+				std::uint64_t const before = slot.sequence.load(std::memory_order_acquire);
+				if (before != 2 * (index + 1))
+					continue;
+
+				auto const failure = Validation_Failure{
+					slot.alias.load(std::memory_order_relaxed),
+					slot.error_message.load(std::memory_order_relaxed),
+					slot.file_name.load(std::memory_order_relaxed),
+					slot.function_name.load(std::memory_order_relaxed),
+					slot.line.load(std::memory_order_relaxed),
+					slot.column.load(std::memory_order_relaxed) };
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (slot.sequence.load(std::memory_order_relaxed) == before)
+					failures.push_back(failure);
+			}
+
+			drained_ = end;
+			return failures;
+		}
+	}
+
+} //namespace
+#endif //header guard
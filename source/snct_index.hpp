@@ -0,0 +1,104 @@
+#ifndef SNCT_INDEX_HPP
+#define SNCT_INDEX_HPP
+
+
+/***************************************************************************************************/
+/* Indices that are in bounds by construction, so element access needs no bounds check             */
+/***************************************************************************************************/
+
+#include "snct_constraints.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <span>
+
+namespace snct
+{
+	template<std::size_t N>
+	using Index = Constrained<std::size_t, LessThan<N>>;
+
+
+
+	namespace detail
+	{
+		// Passes the bound on to the optimizer, so checked operator[] implementations and any
+		// comparisons against N in the caller fold away
+		template<std::size_t N>
+		constexpr std::size_t in_bounds(Index<N> const& i) noexcept
+		{
+			std::size_t const k = i.get();
+			if (k >= N)
+				unreachable();
+			return k;
+		}
+	}
+
+
+
+	// a[i], without a bounds check
+	template<typename T, std::size_t N>
+	[[nodiscard]] constexpr T& at(std::array<T, N>& a, Index<N> const& i) noexcept
+	{
+		return a.data()[detail::in_bounds(i)];
+	}
+
+	template<typename T, std::size_t N>
+	[[nodiscard]] constexpr T const& at(std::array<T, N> const& a, Index<N> const& i) noexcept
+	{
+		return a.data()[detail::in_bounds(i)];
+	}
+
+	template<typename T, std::size_t N>
+		requires (N != std::dynamic_extent)
+	[[nodiscard]] constexpr T& at(std::span<T, N> s, Index<N> const& i) noexcept
+	{
+		return s.data()[detail::in_bounds(i)];
+	}
+
+	template<typename T, std::size_t N>
+	[[nodiscard]] constexpr T& at(T(&a)[N], Index<N> const& i) noexcept
+	{
+		return a[detail::in_bounds(i)];
+	}
+
+
+
+	// Every Index<N> from 0 to N - 1, in order. The values are in bounds by construction, so none of
+	// them is checked.
+	template<std::size_t N>
+	class Index_Range
+	{
+	public:
+		class iterator
+		{
+		public:
+			using value_type = Index<N>;
+			using difference_type = std::ptrdiff_t;
+
+			constexpr Index<N> operator*() const noexcept { return detail::Trusted::make<Index<N>>(i_); }
+			constexpr iterator& operator++() noexcept { ++i_; return *this; }
+			constexpr iterator operator++(int) noexcept { auto const old = *this; ++i_; return old; }
+			constexpr bool operator==(iterator const&) const noexcept = default;
+
+			constexpr iterator() noexcept = default;
+
+		private:
+			friend class Index_Range;
+			constexpr explicit iterator(std::size_t i) noexcept : i_{ i } {}
+			std::size_t i_ = 0;
+		};
+
+		constexpr iterator begin() const noexcept { return iterator{ 0 }; }
+		constexpr iterator end() const noexcept { return iterator{ N }; }
+		static constexpr std::size_t size() noexcept { return N; }
+	};
+
+	template<std::size_t N>
+	[[nodiscard]] constexpr Index_Range<N> indices() noexcept
+	{
+		return {};
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,123 @@
+#ifndef SNCT_INTEGER_MATH_HPP
+#define SNCT_INTEGER_MATH_HPP
+
+
+/***************************************************************************************************/
+/* Division and remainder without a divide instruction, for integers known to be powers of two or   */
+/* multiples of a compile-time factor                                                              */
+/***************************************************************************************************/
+
+#include "snct_constraints.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+
+namespace snct
+{
+	namespace detail
+	{
+		template<typename C>
+		struct Factor_Of
+		{
+			static constexpr std::uintmax_t value = 1;
+		};
+
+		template<auto factor>
+		struct Factor_Of<MultipleOf<factor>>
+		{
+			static constexpr std::uintmax_t value = static_cast<std::uintmax_t>(factor);
+		};
+
+		// The largest factor every value satisfying the whole pack is known to have
+		template<typename ... ConstraintTypes>
+		inline constexpr std::uintmax_t known_factor = [] {
+			std::uintmax_t result = 1;
+			((result = std::lcm(result, Factor_Of<ConstraintTypes>::value)), ...);
+			return result;
+		}();
+
+		template<typename ... ConstraintTypes>
+		inline constexpr bool is_power_of_two = (std::same_as<ConstraintTypes, PowerOfTwo> || ...);
+
+		// U, or unsigned int if U is narrower - 8 and 16 bit operands would otherwise be promoted to
+		// int, where the products overflow
+		template<std::unsigned_integral U>
+		using Unpromoted = std::common_type_t<U, unsigned int>;
+
+		// x * inverse(x) == 1 in unsigned arithmetic, for odd x (Newton's iteration). Computed in the
+		// wider Unpromoted<U>, which is also an inverse modulo the width of U.
+		template<std::unsigned_integral U>
+		constexpr U modular_inverse(U odd) noexcept
+		{
+			using W = Unpromoted<U>;
+			W const x = odd;
+			W inverse = x;
+			for (int i = 0; i < 6; ++i)
+				inverse *= W{ 2 } - x * inverse;
+			return static_cast<U>(inverse);
+		}
+	}
+
+
+
+	// x % divisor, as x & (divisor - 1)
+	template<std::unsigned_integral T, typename ... constraint>
+		requires detail::is_power_of_two<constraint...>
+	[[nodiscard]] constexpr T mod(std::type_identity_t<T> x, Constrained<T, constraint...> const& divisor) noexcept
+	{
+		return x & (divisor.get() - 1);
+	}
+
+
+
+	// x / divisor, as x >> log2(divisor)
+	template<std::unsigned_integral T, typename ... constraint>
+		requires detail::is_power_of_two<constraint...>
+	[[nodiscard]] constexpr T div(std::type_identity_t<T> x, Constrained<T, constraint...> const& divisor) noexcept
+	{
+		return x >> std::countr_zero(divisor.get());
+	}
+
+
+
+	// x rounded down to a multiple of alignment
+	template<std::unsigned_integral T, typename ... constraint>
+		requires detail::is_power_of_two<constraint...>
+	[[nodiscard]] constexpr T round_down(std::type_identity_t<T> x, Constrained<T, constraint...> const& alignment) noexcept
+	{
+		return x & ~(alignment.get() - 1);
+	}
+
+
+
+	// x rounded up to a multiple of alignment (wraps around if the result does not fit in T)
+	template<std::unsigned_integral T, typename ... constraint>
+		requires detail::is_power_of_two<constraint...>
+	[[nodiscard]] constexpr T round_up(std::type_identity_t<T> x, Constrained<T, constraint...> const& alignment) noexcept
+	{
+		return (x + (alignment.get() - 1)) & ~(alignment.get() - 1);
+	}
+
+
+
+	// x / divisor for an x constrained to MultipleOf a multiple of divisor. The division is exact, so
+	// it is done with a shift and a multiplication by the modular inverse of the odd part of divisor.
+	template<auto divisor, std::integral T, typename ... constraint>
+		requires (divisor > 0 && detail::known_factor<constraint...> % static_cast<std::uintmax_t>(divisor) == 0)
+	[[nodiscard]] constexpr T divide_exact(Constrained<T, constraint...> const& x) noexcept
+	{
+		using U = std::make_unsigned_t<T>;
+		constexpr int shift = std::countr_zero(static_cast<U>(divisor));
+		constexpr U inverse = detail::modular_inverse(static_cast<U>(static_cast<U>(divisor) >> shift));
+
+		using W = detail::Unpromoted<U>;
+		T const shifted = static_cast<T>(x.get() >> shift);
+		return static_cast<T>(static_cast<U>(static_cast<W>(static_cast<U>(shifted)) * W{ inverse }));
+	}
+
+} //namespace
+#endif //header guard
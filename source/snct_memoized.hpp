@@ -0,0 +1,160 @@
+#ifndef SNCT_MEMOIZED_HPP
+#define SNCT_MEMOIZED_HPP
+
+
+/***************************************************************************************************/
+/* Remembers the result of an expensive constraint for objects that are wrapped again and again,    */
+/* keyed by the object's address and a generation that changes whenever the object does            */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace snct
+{
+	namespace detail
+	{
+		// Entries per (constraint, value type) - a new result replaces whatever shares its entry
+		inline constexpr std::size_t memo_cache_size = 1024;
+
+		// The default generation: a generation() member function
+		struct Generation_Member
+		{
+			template<typename V>
+			constexpr auto operator()(V const& v) const noexcept -> decltype(v.generation()) { return v.generation(); }
+		};
+
+
+
+		// A seqlock per entry, like the failure log: sequence is odd while a writer fills the entry and
+		// 0 until the first write. Every field is atomic, so readers never race with writers.
+		struct Memo_Entry
+		{
+			std::atomic<std::uint64_t> sequence{ 0 };
+			std::atomic<std::uintptr_t> address{ 0 };
+			std::atomic<std::uint64_t> generation{ 0 };
+			std::atomic<bool> satisfied{ false };
+		};
+
+		// Direct mapped, lock-free, and never allocates. A writer that finds its entry being written
+		// by another thread leaves it be rather than wait.
+		class Memo_Cache
+		{
+		public:
+			std::optional<bool> find(std::uintptr_t address, std::uint64_t generation) const noexcept;
+			void store(std::uintptr_t address, std::uint64_t generation, bool satisfied) noexcept;
+
+		private:
+			static std::size_t index(std::uintptr_t address, std::uint64_t generation) noexcept;
+			Memo_Entry entries_[memo_cache_size];
+		};
+	}
+
+
+
+	// Checks ConstraintType once per object and generation, and after that answers from a cache. For
+	// constraints that walk a large object which is validated many times while it does not change:
+	//
+	//     using Checked_Document = snct::Constrained<Document const&, snct::Memoized<ValidSchema>>;
+	//
+	// GenerationOf(object) must return a number that changes whenever the object is modified - by
+	// default object.generation(). Results are keyed by the object's address, so generations should
+	// also differ between objects that can occupy the same address one after the other, e.g. by
+	// taking them from a global counter. Only usable with a reference as the underlying type.
+	template<typename ConstraintType, typename GenerationOf = detail::Generation_Member>
+	struct Memoized
+	{
+		static constexpr bool uses_object_identity = true;
+
+		template<typename V>
+			requires Constraint<ConstraintType, V const&> && requires(V const& v) { { GenerationOf{}(v) } -> std::convertible_to<std::uint64_t>; }
+		static bool is_satisfied(V const& t) noexcept;
+
+		inline static const char* error_message() noexcept { return ConstraintType::error_message(); }
+
+		// A cache lookup, whatever the wrapped constraint costs
+		static constexpr double cost = 2;
+		static constexpr double rejection_rate = detail::rejection_rate<ConstraintType>();
+
+	private:
+		template<typename V>
+		static inline detail::Memo_Cache cache;
+	};
+
+
+
+	template<typename ConstraintType, typename GenerationOf>
+	template<typename V>
+		requires Constraint<ConstraintType, V const&> && requires(V const& v) { { GenerationOf{}(v) } -> std::convertible_to<std::uint64_t>; }
+	inline bool Memoized<ConstraintType, GenerationOf>::is_satisfied(V const& t) noexcept
+	{
+		auto const address = reinterpret_cast<std::uintptr_t>(std::addressof(t));
+		auto const generation = static_cast<std::uint64_t>(GenerationOf{}(t));
+
+		if (auto const known = cache<V>.find(address, generation))
+			return *known;
+
+		bool const satisfied = ConstraintType::is_satisfied(t) ? true : false;
+		cache<V>.store(address, generation, satisfied);
+		return satisfied;
+	}
+
+
+
+	namespace detail
+	{
+		inline std::size_t Memo_Cache::index(std::uintptr_t address, std::uint64_t generation) noexcept
+		{
+			constexpr std::uint64_t golden = 0x9E3779B97F4A7C15ull;
+			std::uint64_t const hash = (static_cast<std::uint64_t>(address) ^ (generation * golden)) * golden;
+			return static_cast<std::size_t>(hash >> 32) % memo_cache_size;
+		}
+
+
+
+		inline std::optional<bool> Memo_Cache::find(std::uintptr_t address, std::uint64_t generation) const noexcept
+		{
+			Memo_Entry const& entry = entries_[index(address, generation)];
+
+			std::uint64_t const before = entry.sequence.load(std::memory_order_acquire);
+			if (before == 0 || before % 2 != 0)
+				return std::nullopt;
+
+			std::uintptr_t const a = entry.address.load(std::memory_order_relaxed);
+			std::uint64_t const g = entry.generation.load(std::memory_order_relaxed);
+			bool const satisfied = entry.satisfied.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (entry.sequence.load(std::memory_order_relaxed) != before || a != address || g != generation)
+				return std::nullopt;
+
+			return satisfied;
+		}
+
+
+
+		inline void Memo_Cache::store(std::uintptr_t address, std::uint64_t generation, bool satisfied) noexcept
+		{
+			Memo_Entry& entry = entries_[index(address, generation)];
+
+			std::uint64_t sequence = entry.sequence.load(std::memory_order_relaxed);
+			if (sequence % 2 != 0 || !entry.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed))
+				return;
+			std::atomic_thread_fence(std::memory_order_release);
+
+			entry.address.store(address, std::memory_order_relaxed);
+			entry.generation.store(generation, std::memory_order_relaxed);
+			entry.satisfied.store(satisfied, std::memory_order_relaxed);
+
+			entry.sequence.store(sequence + 2, std::memory_order_release);
+		}
+	}
+
+} //namespace
+#endif //header guard
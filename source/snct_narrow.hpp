@@ -0,0 +1,83 @@
+#ifndef SNCT_NARROW_HPP
+#define SNCT_NARROW_HPP
+
+
+/***************************************************************************************************/
+/* Conversions to a smaller arithmetic type that are proven safe by the constraints at compile time */
+/***************************************************************************************************/
+
+#include "snct_bounds.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace snct
+{
+	namespace detail
+	{
+		// 2^exponent, exactly
+		constexpr long double power_of_two(int exponent) noexcept
+		{
+			long double p = 1;
+			for (int i = 0; i < exponent; ++i)
+				p *= 2;
+			return p;
+		}
+
+		// Every value in the interval can be converted to U without overflow. Integers converted to
+		// floating point types must also be exact; floating point values converted to integers are
+		// truncated, as by static_cast.
+		template<typename U, typename Number>
+		constexpr bool fits_in(Interval<Number> i) noexcept
+		{
+			if (!i.lo_known || !i.hi_known)
+				return false;
+
+			constexpr int digits = std::numeric_limits<U>::digits;
+
+			if constexpr (std::integral<Number> && std::integral<U>)
+				return std::in_range<U>(i.lo) && std::in_range<U>(i.hi);
+
+			else if constexpr (std::integral<Number> && std::floating_point<U>)
+			{
+				if constexpr (digits >= std::numeric_limits<std::intmax_t>::digits)
+					return true;
+				else
+				{
+					constexpr std::intmax_t exact = std::intmax_t{ 1 } << digits;
+					return -exact <= i.lo && i.hi <= exact;
+				}
+			}
+
+			else if constexpr (std::floating_point<Number> && std::integral<U>)
+			{
+				constexpr long double above_max = power_of_two(digits);
+				constexpr long double lowest = std::is_signed_v<U> ? -above_max : -1.0L;
+				return (std::is_signed_v<U> ? lowest <= i.lo : lowest < i.lo) && i.hi < above_max;
+			}
+
+			else
+				return std::numeric_limits<U>::lowest() <= i.lo && i.hi <= std::numeric_limits<U>::max();
+		}
+	}
+
+
+
+	// The value converted to U with a plain cast. Only compiles when the constraints prove that every
+	// value fits - e.g. Minimum<0> and Maximum<1000> on an int64_t fit in a uint16_t. Floating point
+	// values need a lower and an upper bound, which also rule out NaN and infinities.
+	template<typename U, typename T, typename ... constraint>
+		requires std::is_arithmetic_v<U> && (!std::same_as<U, bool>) && std::is_arithmetic_v<std::remove_cvref_t<T>>
+	[[nodiscard]] constexpr U narrow_to(Constrained<T, constraint...> const& c) noexcept
+	{
+		static_assert(detail::fits_in<U>(detail::interval_of<std::remove_cvref_t<T>, constraint...>()),
+			"snct::narrow_to: the constraints do not keep every value within the range of the target type");
+
+		return static_cast<U>(c.get());
+	}
+
+} //namespace
+#endif //header guard
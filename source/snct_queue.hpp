@@ -0,0 +1,355 @@
+#ifndef SNCT_QUEUE_HPP
+#define SNCT_QUEUE_HPP
+
+
+/***************************************************************************************************/
+/* A fixed-size lock-free queue of constrained values: producers check what they push, so consumers */
+/* receive Constrained values without checking them again                                          */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <source_location>
+#include <span>
+#include <type_traits>
+
+namespace snct
+{
+	enum class Queue_Sharing
+	{
+		spsc,  // one producer thread and one consumer thread
+		mpmc   // any number of each
+	};
+
+
+
+	namespace detail
+	{
+		template<typename U, Queue_Sharing sharing>
+		struct Queue_Slot
+		{
+			U value;
+		};
+
+		// As in Vyukov's bounded queue: sequence is the position the slot can next be written at, and
+		// that position + 1 once the value is there to be read
+		template<typename U>
+		struct Queue_Slot<U, Queue_Sharing::mpmc>
+		{
+			std::atomic<std::uint64_t> sequence;
+			U value;
+		};
+
+		// A run of slots claimed by one push or pop
+		struct Queue_Claim
+		{
+			std::uint64_t position = 0;
+			std::size_t count = 0;
+		};
+	}
+
+
+
+	// A ring buffer of capacity values of Alias, which must be a Constrained alias of a trivially
+	// copyable type. Values are checked once, when they are pushed - pop hands them out as Alias with
+	// no check at all. Pushes and pops of a whole span claim their slots together, with one atomic
+	// operation for the run.
+	//
+	// The head and tail indices are on separate cache lines, away from the slots. There are no pointers
+	// and nothing is allocated, so a queue constructed in memory shared between processes - with
+	// placement new, by one of them - can be used from all of them, as long as each is built with the
+	// same compiler, settings and Alias.
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing = Queue_Sharing::spsc>
+	class ConstrainedQueue
+	{
+		using Underlying = typename Alias::Underlying;
+
+		static_assert(std::is_trivially_copyable_v<Underlying> && std::is_trivially_copyable_v<Alias>,
+			"snct::ConstrainedQueue: values are copied in and out of the slots, so they must be trivially copyable");
+		static_assert(slot_count > 0 && (slot_count & (slot_count - 1)) == 0, "snct::ConstrainedQueue: the capacity must be a power of two");
+		static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+			"snct::ConstrainedQueue: needs lock-free 64 bit atomics, which are also what makes it usable in shared memory");
+
+	public:
+	// META
+		using value_type = Alias;
+		using size_type = std::size_t;
+
+		static constexpr size_type capacity = slot_count;
+
+	// CONSTRUCTION
+		ConstrainedQueue() noexcept;
+		ConstrainedQueue(ConstrainedQueue const&) = delete;
+		ConstrainedQueue& operator=(ConstrainedQueue const&) = delete;
+
+	// PRODUCER
+		// Push as many values as fit, in order, and return how many that was. Constrained values are
+		// not checked again.
+		bool try_push(Alias value) noexcept;
+		size_type push(std::span<Alias const> values) noexcept;
+
+		// Checks the values before any of them is pushed, and pushes the longest prefix that satisfies
+		// every constraint and fits. If a value is rejected, it is passed to the failure log and
+		// violation hook - if enabled - and it and the values after it are left to the caller.
+		size_type push(std::span<Underlying const> values, std::source_location location = std::source_location::current()) noexcept;
+
+	// CONSUMER
+		[[nodiscard]] std::optional<Alias> try_pop() noexcept;
+
+		// Pops as many values as are queued, up to out.size(), and returns how many that was
+		size_type pop(std::span<Alias> out) noexcept;
+
+	// ACCESS
+		// Only a snapshot while other threads push and pop
+		[[nodiscard]] size_type size() const noexcept;
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+	private:
+		static constexpr std::uint64_t mask = slot_count - 1;
+
+		// Claims up to n slots, and hands them over once they are written or read
+		detail::Queue_Claim claim_push(size_type n) noexcept;
+		void release_push(detail::Queue_Claim claim) noexcept;
+		detail::Queue_Claim claim_pop(size_type n) noexcept;
+		void release_pop(detail::Queue_Claim claim) noexcept;
+
+		template<typename Value_Of>
+		size_type push_n(size_type n, Value_Of value_of) noexcept;
+
+		// How many of n values a push could take now - exact with a single producer, while with
+		// several another producer may take some of the room first
+		size_type room(size_type n) noexcept;
+
+		Underlying& value_at(std::uint64_t position) noexcept { return slots_[position & mask].value; }
+
+		// Written by producers. With a single producer, head_seen_ is the last head it read, so it only
+		// reads head_ - from the consumer's cache line - when the queue looks full.
+		alignas(64) std::atomic<std::uint64_t> tail_{ 0 };
+		std::uint64_t head_seen_ = 0;
+
+		// Written by consumers, and the same the other way round
+		alignas(64) std::atomic<std::uint64_t> head_{ 0 };
+		std::uint64_t tail_seen_ = 0;
+
+		alignas(64) std::array<detail::Queue_Slot<Underlying, sharing>, slot_count> slots_;
+	};
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline ConstrainedQueue<Alias, slot_count, sharing>::ConstrainedQueue() noexcept
+	{
+		if constexpr (sharing == Queue_Sharing::mpmc)
+		{
+			for (std::uint64_t i = 0; i < slot_count; ++i)
+				slots_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline bool ConstrainedQueue<Alias, slot_count, sharing>::try_push(Alias value) noexcept
+	{
+		return push_n(1, [&](size_type) { return value.get(); }) == 1;
+	}
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline auto ConstrainedQueue<Alias, slot_count, sharing>::push(std::span<Alias const> values) noexcept -> size_type
+	{
+		return push_n(values.size(), [&](size_type i) { return values[i].get(); });
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline auto ConstrainedQueue<Alias, slot_count, sharing>::push(std::span<Underlying const> values, std::source_location location) noexcept -> size_type
+	{
+		// Values that cannot fit are not checked
+		values = values.first(room(values.size()));
+
+		size_type valid = 0;
+		while (valid < values.size() && Alias::satisfies_constraints(values[valid]))
+			++valid;
+
+		if (valid < values.size())
+			(void)Alias::factory(values[valid], location);  // only to report the rejection
+
+		return push_n(valid, [&](size_type i) { return values[i]; });
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	template<typename Value_Of>
+	inline auto ConstrainedQueue<Alias, slot_count, sharing>::push_n(size_type n, Value_Of value_of) noexcept -> size_type
+	{
+		auto const claim = claim_push(n);
+		for (size_type i = 0; i < claim.count; ++i)
+			value_at(claim.position + i) = value_of(i);
+		release_push(claim);
+		return claim.count;
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline auto ConstrainedQueue<Alias, slot_count, sharing>::room(size_type n) noexcept -> size_type
+	{
+		// A single producer's claim changes nothing until it is released
+		if constexpr (sharing == Queue_Sharing::spsc)
+			return claim_push(n).count;
+		else
+			return std::min(n, capacity - size());
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline auto ConstrainedQueue<Alias, slot_count, sharing>::try_pop() noexcept -> std::optional<Alias>
+	{
+		auto const claim = claim_pop(1);
+		if (claim.count == 0)
+			return std::nullopt;
+
+		auto const value = detail::Trusted::make<Alias>(value_at(claim.position));
+		release_pop(claim);
+		return value;
+	}
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline auto ConstrainedQueue<Alias, slot_count, sharing>::pop(std::span<Alias> out) noexcept -> size_type
+	{
+		auto const claim = claim_pop(out.size());
+		for (size_type i = 0; i < claim.count; ++i)
+			out[i] = detail::Trusted::make<Alias>(value_at(claim.position + i));
+		release_pop(claim);
+		return claim.count;
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline auto ConstrainedQueue<Alias, slot_count, sharing>::size() const noexcept -> size_type
+	{
+		// The tail is read last, so it is never behind the head it is compared with
+		std::uint64_t const head = head_.load(std::memory_order_acquire);
+		std::uint64_t const tail = tail_.load(std::memory_order_acquire);
+		return static_cast<size_type>(std::min<std::uint64_t>(tail - head, slot_count));
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline detail::Queue_Claim ConstrainedQueue<Alias, slot_count, sharing>::claim_push(size_type n) noexcept
+	{
+		std::uint64_t position = tail_.load(std::memory_order_relaxed);
+
+		if constexpr (sharing == Queue_Sharing::spsc)
+		{
+			if (slot_count - (position - head_seen_) < n)
+				head_seen_ = head_.load(std::memory_order_acquire);
+			return { position, static_cast<size_type>(std::min<std::uint64_t>(n, slot_count - (position - head_seen_))) };
+		}
+		else
+		{
+			// Counts the free slots from position, then takes them all with one compare-and-swap. No
+			// other producer can claim a slot at or after the tail, so they stay free until then.
+			for (;;)
+			{
+				size_type count = 0;
+				std::int64_t difference = 0;
+				for (; count < n; ++count)
+				{
+					difference = static_cast<std::int64_t>(slots_[(position + count) & mask].sequence.load(std::memory_order_acquire) - (position + count));
+					if (difference != 0)
+						break;
+				}
+
+				// Behind position: the queue is full. Ahead of it: another producer got there first.
+				if (count == 0 && difference > 0)
+				{
+					position = tail_.load(std::memory_order_relaxed);
+					continue;
+				}
+				if (count == 0 || tail_.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+					return { position, count };
+			}
+		}
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline void ConstrainedQueue<Alias, slot_count, sharing>::release_push(detail::Queue_Claim claim) noexcept
+	{
+		if constexpr (sharing == Queue_Sharing::spsc)
+			tail_.store(claim.position + claim.count, std::memory_order_release);
+		else
+		{
+			for (size_type i = 0; i < claim.count; ++i)
+				slots_[(claim.position + i) & mask].sequence.store(claim.position + i + 1, std::memory_order_release);
+		}
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline detail::Queue_Claim ConstrainedQueue<Alias, slot_count, sharing>::claim_pop(size_type n) noexcept
+	{
+		std::uint64_t position = head_.load(std::memory_order_relaxed);
+
+		if constexpr (sharing == Queue_Sharing::spsc)
+		{
+			if (tail_seen_ - position < n)
+				tail_seen_ = tail_.load(std::memory_order_acquire);
+			return { position, static_cast<size_type>(std::min<std::uint64_t>(n, tail_seen_ - position)) };
+		}
+		else
+		{
+			// The same, for slots whose values have been released by their producers
+			for (;;)
+			{
+				size_type count = 0;
+				std::int64_t difference = 0;
+				for (; count < n; ++count)
+				{
+					difference = static_cast<std::int64_t>(slots_[(position + count) & mask].sequence.load(std::memory_order_acquire) - (position + count + 1));
+					if (difference != 0)
+						break;
+				}
+
+				// Behind position: nothing is queued. Ahead of it: another consumer got there first.
+				if (count == 0 && difference > 0)
+				{
+					position = head_.load(std::memory_order_relaxed);
+					continue;
+				}
+				if (count == 0 || head_.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+					return { position, count };
+			}
+		}
+	}
+
+
+
+	template<typename Alias, std::size_t slot_count, Queue_Sharing sharing>
+	inline void ConstrainedQueue<Alias, slot_count, sharing>::release_pop(detail::Queue_Claim claim) noexcept
+	{
+		if constexpr (sharing == Queue_Sharing::spsc)
+			head_.store(claim.position + claim.count, std::memory_order_release);
+		else
+		{
+			for (size_type i = 0; i < claim.count; ++i)
+				slots_[(claim.position + i) & mask].sequence.store(claim.position + i + slot_count, std::memory_order_release);
+		}
+	}
+
+} //namespace
+#endif //header guard
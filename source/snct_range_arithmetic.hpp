@@ -0,0 +1,194 @@
+#ifndef SNCT_RANGE_ARITHMETIC_HPP
+#define SNCT_RANGE_ARITHMETIC_HPP
+
+
+/***************************************************************************************************/
+/* +, - and * on integers constrained to a range. The range of the result is worked out at compile  */
+/* time, so the result is only checked when it might not fit in the underlying type.               */
+/***************************************************************************************************/
+
+#include "snct_bounds.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace snct
+{
+	namespace detail
+	{
+		using Integer_Interval = Interval<std::intmax_t>;
+
+		template<typename T, typename ... ConstraintTypes>
+		concept Range_Constrained =
+			std::integral<T> && !std::same_as<T, bool> && std::same_as<T, std::remove_cv_t<T>> &&
+			(Bound_Constraint<ConstraintTypes> && ...);
+
+
+
+		// Each of these stores t op u in result and returns true, or returns false if it overflows T.
+		// Unlike the compiler builtins, they can be used in constant expressions on every compiler.
+		template<std::integral T>
+		constexpr bool checked_add(T t, T u, T& result) noexcept
+		{
+			constexpr T min = std::numeric_limits<T>::min();
+			constexpr T max = std::numeric_limits<T>::max();
+			if (u > 0 ? t > max - u : t < min - u)
+				return false;
+			result = static_cast<T>(t + u);
+			return true;
+		}
+
+		template<std::integral T>
+		constexpr bool checked_subtract(T t, T u, T& result) noexcept
+		{
+			constexpr T min = std::numeric_limits<T>::min();
+			constexpr T max = std::numeric_limits<T>::max();
+			if (u > 0 ? t < min + u : t > max + u)
+				return false;
+			result = static_cast<T>(t - u);
+			return true;
+		}
+
+		template<std::integral T>
+		constexpr bool checked_multiply(T t, T u, T& result) noexcept
+		{
+			constexpr T min = std::numeric_limits<T>::min();
+			constexpr T max = std::numeric_limits<T>::max();
+			bool overflow;
+			if (t > 0)
+				overflow = u > 0 ? t > max / u : u < min / t;
+			else
+				overflow = u > 0 ? t < min / u : (t != 0 && u < max / t);
+			if (overflow)
+				return false;
+			result = static_cast<T>(t * u);
+			return true;
+		}
+
+
+
+		constexpr Integer_Interval interval_sum(Integer_Interval a, Integer_Interval b) noexcept
+		{
+			auto r = Integer_Interval{};
+			r.lo_known = a.lo_known && b.lo_known && checked_add(a.lo, b.lo, r.lo);
+			r.hi_known = a.hi_known && b.hi_known && checked_add(a.hi, b.hi, r.hi);
+			return r;
+		}
+
+		constexpr Integer_Interval interval_difference(Integer_Interval a, Integer_Interval b) noexcept
+		{
+			auto r = Integer_Interval{};
+			r.lo_known = a.lo_known && b.hi_known && checked_subtract(a.lo, b.hi, r.lo);
+			r.hi_known = a.hi_known && b.lo_known && checked_subtract(a.hi, b.lo, r.hi);
+			return r;
+		}
+
+		// The extremes of a product are among the products of the extremes. If any of those is unknown
+		// or overflows, neither bound of the result is known.
+		constexpr Integer_Interval interval_product(Integer_Interval a, Integer_Interval b) noexcept
+		{
+			if (!(a.lo_known && a.hi_known && b.lo_known && b.hi_known))
+				return Integer_Interval{};
+
+			std::intmax_t products[4] = {};
+			if (!(checked_multiply(a.lo, b.lo, products[0]) && checked_multiply(a.lo, b.hi, products[1]) &&
+				checked_multiply(a.hi, b.lo, products[2]) && checked_multiply(a.hi, b.hi, products[3])))
+				return Integer_Interval{};
+
+			auto const [lo, hi] = std::minmax({ products[0], products[1], products[2], products[3] });
+			return Integer_Interval{ lo, hi, true, true };
+		}
+
+
+
+		// The result always fits in T, so it needs no check
+		template<std::integral T>
+		constexpr bool is_proven(Integer_Interval i) noexcept
+		{
+			return i.lo_known && i.hi_known && std::in_range<T>(i.lo) && std::in_range<T>(i.hi);
+		}
+
+		template<std::integral T, Integer_Interval range>
+		using Range_Result = Constrained<T, Minimum<lowest_in<T>(range)>, Maximum<highest_in<T>(range)>>;
+
+
+
+		struct Add
+		{
+			template<std::integral T> static constexpr T apply(T t, T u) noexcept { return static_cast<T>(t + u); }
+			template<std::integral T> static constexpr bool checked(T t, T u, T& result) noexcept { return checked_add(t, u, result); }
+		};
+
+		struct Subtract
+		{
+			template<std::integral T> static constexpr T apply(T t, T u) noexcept { return static_cast<T>(t - u); }
+			template<std::integral T> static constexpr bool checked(T t, T u, T& result) noexcept { return checked_subtract(t, u, result); }
+		};
+
+		struct Multiply
+		{
+			template<std::integral T> static constexpr T apply(T t, T u) noexcept { return static_cast<T>(t * u); }
+			template<std::integral T> static constexpr bool checked(T t, T u, T& result) noexcept { return checked_multiply(t, u, result); }
+		};
+
+		// Proven results are computed and wrapped without a check. Anything else is computed with an
+		// overflow check and constructed normally, so it throws Constraint_Exception if it does not fit.
+		template<typename Operation, std::integral T, Integer_Interval range>
+		constexpr Range_Result<T, range> range_result(T t, T u) noexcept(is_proven<T>(range))
+		{
+			using Result = Range_Result<T, range>;
+
+			if constexpr (is_proven<T>(range))
+				return Trusted::make<Result>(Operation::apply(t, u));
+			else
+			{
+				T result{};
+				if (!Operation::checked(t, u, result))
+					throw Constraint_Exception{ "Arithmetic on 'snct::Constrained' values overflowed the underlying type" };
+				return Result{ result };
+			}
+		}
+	}
+
+
+
+	// a + b, constrained to [min(a) + min(b), max(a) + max(b)]
+	template<typename T, typename ... A, typename ... B>
+		requires detail::Range_Constrained<T, A...> && detail::Range_Constrained<T, B...>
+	[[nodiscard]] constexpr auto operator+(Constrained<T, A...> const& a, Constrained<T, B...> const& b)
+		noexcept(detail::is_proven<T>(detail::interval_sum(detail::interval_of<T, A...>(), detail::interval_of<T, B...>())))
+	{
+		constexpr auto range = detail::interval_sum(detail::interval_of<T, A...>(), detail::interval_of<T, B...>());
+		return detail::range_result<detail::Add, T, range>(a.get(), b.get());
+	}
+
+
+
+	// a - b, constrained to [min(a) - max(b), max(a) - min(b)]
+	template<typename T, typename ... A, typename ... B>
+		requires detail::Range_Constrained<T, A...> && detail::Range_Constrained<T, B...>
+	[[nodiscard]] constexpr auto operator-(Constrained<T, A...> const& a, Constrained<T, B...> const& b)
+		noexcept(detail::is_proven<T>(detail::interval_difference(detail::interval_of<T, A...>(), detail::interval_of<T, B...>())))
+	{
+		constexpr auto range = detail::interval_difference(detail::interval_of<T, A...>(), detail::interval_of<T, B...>());
+		return detail::range_result<detail::Subtract, T, range>(a.get(), b.get());
+	}
+
+
+
+	// a * b, constrained to the smallest and largest products of the bounds of a and b
+	template<typename T, typename ... A, typename ... B>
+		requires detail::Range_Constrained<T, A...> && detail::Range_Constrained<T, B...>
+	[[nodiscard]] constexpr auto operator*(Constrained<T, A...> const& a, Constrained<T, B...> const& b)
+		noexcept(detail::is_proven<T>(detail::interval_product(detail::interval_of<T, A...>(), detail::interval_of<T, B...>())))
+	{
+		constexpr auto range = detail::interval_product(detail::interval_of<T, A...>(), detail::interval_of<T, B...>());
+		return detail::range_result<detail::Multiply, T, range>(a.get(), b.get());
+	}
+
+} //namespace
+#endif //header guard
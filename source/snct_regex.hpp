@@ -0,0 +1,530 @@
+#ifndef SNCT_REGEX_HPP
+#define SNCT_REGEX_HPP
+
+
+/***************************************************************************************************/
+/* A small regular expression compiler that runs entirely at compile time and produces a DFA        */
+/*                                                                                                 */
+/* Supported: literals, . (any byte), [classes], [^negated classes], \d \D \w \W \s \S, escaped     */
+/* metacharacters, ( groups ), | alternation, and the quantifiers * + ? {m} {m,} {m,n}.             */
+/* Matching is always against the whole string - a leading ^ and trailing $ are accepted and       */
+/* ignored. Backreferences, lookaround and lazy quantifiers are not supported.                     */
+/***************************************************************************************************/
+
+#include "snct_constraints.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace snct
+{
+	namespace detail::regex
+	{
+		// Not constexpr - calling it during constant evaluation stops compilation, and the compiler
+		// error points here with the message as the argument
+		inline void compile_error(char const*) {}
+
+		inline constexpr std::size_t max_positions = 255;
+		inline constexpr std::size_t max_states = 4096;
+
+
+
+		struct Bits256
+		{
+			std::array<std::uint64_t, 4> words{};
+
+			constexpr void set(std::size_t i) noexcept { words[i / 64] |= std::uint64_t{ 1 } << (i % 64); }
+			constexpr bool test(std::size_t i) const noexcept { return (words[i / 64] >> (i % 64)) & 1u; }
+			constexpr bool any() const noexcept { return (words[0] | words[1] | words[2] | words[3]) != 0; }
+
+			constexpr void set_range(unsigned char lo, unsigned char hi) noexcept
+			{
+				for (unsigned c = lo; c <= hi; ++c)
+					set(c);
+			}
+
+			constexpr Bits256 operator~() const noexcept
+			{
+				return { { ~words[0], ~words[1], ~words[2], ~words[3] } };
+			}
+
+			constexpr Bits256& operator|=(Bits256 const& other) noexcept
+			{
+				for (std::size_t w = 0; w < 4; ++w)
+					words[w] |= other.words[w];
+				return *this;
+			}
+
+			constexpr Bits256 operator&(Bits256 const& other) const noexcept
+			{
+				return { { words[0] & other.words[0], words[1] & other.words[1], words[2] & other.words[2], words[3] & other.words[3] } };
+			}
+
+			template<typename F>
+			constexpr void for_each(F f) const
+			{
+				for (std::size_t w = 0; w < 4; ++w)
+					for (std::uint64_t bits = words[w]; bits != 0; bits &= bits - 1)
+						f(w * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+			}
+
+			// Differs between most sets, and is cheaper to compare than the sets themselves
+			constexpr std::uint64_t key() const noexcept
+			{
+				return words[0] ^ std::rotl(words[1], 16) ^ std::rotl(words[2], 32) ^ std::rotl(words[3], 48);
+			}
+
+			constexpr bool operator==(Bits256 const& other) const noexcept
+			{
+				return words[0] == other.words[0] && words[1] == other.words[1] && words[2] == other.words[2] && words[3] == other.words[3];
+			}
+		};
+
+
+
+		enum class Kind { empty, leaf, concatenation, alternation, star, plus, optional };
+
+		struct Node
+		{
+			Kind kind = Kind::empty;
+			int a = -1;
+			int b = -1;
+			Bits256 chars{};
+		};
+
+
+
+		class Parser
+		{
+		public:
+			constexpr Parser(std::string_view pattern, std::vector<Node>& nodes) : pattern_{ pattern }, nodes_{ nodes }
+			{
+				if (!pattern_.empty() && pattern_.front() == '^')
+					pattern_.remove_prefix(1);
+				if (!pattern_.empty() && pattern_.back() == '$' && !(pattern_.size() > 1 && pattern_[pattern_.size() - 2] == '\\'))
+					pattern_.remove_suffix(1);
+			}
+
+			constexpr int parse()
+			{
+				int const root = alternation();
+				if (i_ != pattern_.size())
+					compile_error("snct::Matches - unbalanced ')' in pattern");
+				return root;
+			}
+
+		private:
+			std::string_view pattern_;
+			std::vector<Node>& nodes_;
+			std::size_t i_ = 0;
+
+			constexpr bool at_end() const { return i_ >= pattern_.size(); }
+			constexpr char peek() const { return pattern_[i_]; }
+			constexpr char next()
+			{
+				if (at_end())
+					compile_error("snct::Matches - pattern ends unexpectedly");
+				return pattern_[i_++];
+			}
+
+			constexpr int add(Node node)
+			{
+				nodes_.push_back(node);
+				return static_cast<int>(nodes_.size()) - 1;
+			}
+
+			constexpr int add(Kind kind, int a = -1, int b = -1) { return add(Node{ kind, a, b, {} }); }
+
+			constexpr int clone(int n)
+			{
+				Node copy = nodes_[n];
+				if (copy.a >= 0) copy.a = clone(copy.a);
+				if (copy.b >= 0) copy.b = clone(copy.b);
+				return add(copy);
+			}
+
+			constexpr int alternation()
+			{
+				int left = concatenation();
+				while (!at_end() && peek() == '|')
+				{
+					++i_;
+					left = add(Kind::alternation, left, concatenation());
+				}
+				return left;
+			}
+
+			constexpr int concatenation()
+			{
+				int left = add(Kind::empty);
+				while (!at_end() && peek() != '|' && peek() != ')')
+					left = add(Kind::concatenation, left, repetition());
+				return left;
+			}
+
+			constexpr std::size_t number()
+			{
+				if (at_end() || peek() < '0' || '9' < peek())
+					compile_error("snct::Matches - expected a number in {m,n}");
+
+				std::size_t n = 0;
+				while (!at_end() && '0' <= peek() && peek() <= '9')
+					n = n * 10 + static_cast<std::size_t>(next() - '0');
+				return n;
+			}
+
+			constexpr int repetition()
+			{
+				int item = atom();
+				while (!at_end())
+				{
+					char const c = peek();
+					if (c == '*') { ++i_; item = add(Kind::star, item); }
+					else if (c == '+') { ++i_; item = add(Kind::plus, item); }
+					else if (c == '?') { ++i_; item = add(Kind::optional, item); }
+					else if (c == '{') { ++i_; item = counted(item); }
+					else break;
+				}
+				return item;
+			}
+
+			// x{m,n} becomes m copies of x followed by n-m copies of x?, and x{m,} ends in x* instead
+			constexpr int counted(int item)
+			{
+				std::size_t const min = number();
+				std::size_t max = min;
+				bool unbounded = false;
+
+				if (!at_end() && peek() == ',')
+				{
+					++i_;
+					if (!at_end() && peek() == '}')
+						unbounded = true;
+					else
+						max = number();
+				}
+				if (next() != '}')
+					compile_error("snct::Matches - expected '}'");
+				if (max < min)
+					compile_error("snct::Matches - {m,n} with n less than m");
+
+				int result = add(Kind::empty);
+				for (std::size_t k = 0; k < min; ++k)
+					result = add(Kind::concatenation, result, clone(item));
+				if (unbounded)
+					result = add(Kind::concatenation, result, add(Kind::star, clone(item)));
+				else
+					for (std::size_t k = min; k < max; ++k)
+						result = add(Kind::concatenation, result, add(Kind::optional, clone(item)));
+				return result;
+			}
+
+			constexpr int leaf(Bits256 chars) { return add(Node{ Kind::leaf, -1, -1, chars }); }
+
+			constexpr int atom()
+			{
+				char const c = next();
+				switch (c)
+				{
+				case '(':
+				{
+					int const inner = alternation();
+					if (next() != ')')
+						compile_error("snct::Matches - expected ')'");
+					return inner;
+				}
+				case '[': return leaf(bracket());
+				case '.': return leaf(~Bits256{});
+				case '\\': return leaf(escape(next()));
+				case '*': case '+': case '?': case '{':
+					compile_error("snct::Matches - quantifier without anything to repeat");
+					return -1;
+				default:
+				{
+					Bits256 chars{};
+					chars.set(static_cast<unsigned char>(c));
+					return leaf(chars);
+				}
+				}
+			}
+
+			static constexpr char escaped_char(char c)
+			{
+				switch (c)
+				{
+				case 'n': return '\n';
+				case 't': return '\t';
+				case 'r': return '\r';
+				case 'f': return '\f';
+				case 'v': return '\v';
+				default: return c;
+				}
+			}
+
+			static constexpr Bits256 escape(char c)
+			{
+				Bits256 chars{};
+				switch (c)
+				{
+				case 'd': case 'D':
+					chars.set_range('0', '9');
+					break;
+				case 'w': case 'W':
+					chars.set_range('a', 'z'); chars.set_range('A', 'Z'); chars.set_range('0', '9'); chars.set('_');
+					break;
+				case 's': case 'S':
+					for (char ws : { ' ', '\t', '\n', '\r', '\f', '\v' }) chars.set(static_cast<unsigned char>(ws));
+					break;
+				default: chars.set(static_cast<unsigned char>(escaped_char(c))); return chars;
+				}
+				return (c == 'D' || c == 'W' || c == 'S') ? ~chars : chars;
+			}
+
+			constexpr Bits256 bracket()
+			{
+				bool const negated = !at_end() && peek() == '^';
+				if (negated)
+					++i_;
+
+				Bits256 chars{};
+				bool first = true;
+				while (first || peek() != ']')
+				{
+					first = false;
+					char lo = next();
+					if (lo == '\\')
+					{
+						char const e = next();
+						if (e == 'd' || e == 'D' || e == 'w' || e == 'W' || e == 's' || e == 'S')
+						{
+							chars |= escape(e);
+							continue;
+						}
+						lo = escaped_char(e);
+					}
+
+					if (i_ + 1 < pattern_.size() && peek() == '-' && pattern_[i_ + 1] != ']')
+					{
+						++i_;
+						char hi = next();
+						if (hi == '\\')
+							hi = escaped_char(next());
+						if (static_cast<unsigned char>(hi) < static_cast<unsigned char>(lo))
+							compile_error("snct::Matches - character range out of order");
+						chars.set_range(static_cast<unsigned char>(lo), static_cast<unsigned char>(hi));
+					}
+					else
+						chars.set(static_cast<unsigned char>(lo));
+
+					if (at_end())
+						compile_error("snct::Matches - expected ']'");
+				}
+				++i_;
+				return negated ? ~chars : chars;
+			}
+		};
+
+
+
+		struct Glushkov
+		{
+			bool nullable = false;
+			Bits256 first{};
+			Bits256 last{};
+		};
+
+		// Positions are numbered from 1 - position 0 is the start of the string
+		struct Automaton
+		{
+			std::vector<Node> const& nodes;
+			std::vector<Bits256> position_chars{ Bits256{} };
+			std::vector<Bits256> follow{ Bits256{} };
+
+			constexpr Glushkov analyze(int n)
+			{
+				Node const node = nodes[n];
+				switch (node.kind)
+				{
+				case Kind::empty:
+					return { true, {}, {} };
+
+				case Kind::leaf:
+				{
+					if (position_chars.size() > max_positions)
+						compile_error("snct::Matches - pattern too long, more than 255 character positions after expanding {m,n}");
+					Bits256 self{};
+					self.set(position_chars.size());
+					position_chars.push_back(node.chars);
+					follow.push_back({});
+					return { false, self, self };
+				}
+
+				case Kind::concatenation:
+				{
+					Glushkov const a = analyze(node.a);
+					Glushkov const b = analyze(node.b);
+					a.last.for_each([&](std::size_t p) { follow[p] |= b.first; });
+
+					Glushkov result{ a.nullable && b.nullable, a.first, b.last };
+					if (a.nullable) result.first |= b.first;
+					if (b.nullable) result.last |= a.last;
+					return result;
+				}
+
+				case Kind::alternation:
+				{
+					Glushkov result = analyze(node.a);
+					Glushkov const b = analyze(node.b);
+					result.nullable = result.nullable || b.nullable;
+					result.first |= b.first;
+					result.last |= b.last;
+					return result;
+				}
+
+				case Kind::star:
+				case Kind::plus:
+				case Kind::optional:
+				{
+					Glushkov result = analyze(node.a);
+					if (node.kind != Kind::optional)
+						result.last.for_each([&](std::size_t p) { follow[p] |= result.first; });
+					if (node.kind != Kind::plus)
+						result.nullable = true;
+					return result;
+				}
+				}
+				return {};
+			}
+		};
+
+
+
+		// The DFA while it is being built. State 0 is the dead state and state 1 the start state.
+		struct Dfa_Builder
+		{
+			std::array<std::uint16_t, 256> class_of{};
+			std::vector<Bits256> class_positions{};
+			std::vector<Bits256> states{};
+			std::vector<std::uint64_t> state_keys{};  // key() of each state
+			std::vector<std::uint16_t> next{};
+			std::vector<bool> accepting{};
+
+			constexpr explicit Dfa_Builder(std::string_view pattern)
+			{
+				std::vector<Node> nodes{};
+				int const root = Parser{ pattern, nodes }.parse();
+
+				Automaton automaton{ nodes };
+				Glushkov const whole = automaton.analyze(root);
+				automaton.follow[0] = whole.first;
+
+				// Bytes that no position distinguishes share a class, and a column in the table. The
+				// positions each byte can stand at are collected from the positions' own sets, so a
+				// position costs the bytes it matches rather than all 256.
+				std::array<Bits256, 256> signatures{};
+				for (std::size_t p = 1; p < automaton.position_chars.size(); ++p)
+					automaton.position_chars[p].for_each([&](std::size_t c) { signatures[c].set(p); });
+
+				for (unsigned c = 0; c < 256; ++c)
+				{
+					Bits256 const& signature = signatures[c];
+
+					auto const found = std::find(class_positions.begin(), class_positions.end(), signature);
+					class_of[c] = static_cast<std::uint16_t>(found - class_positions.begin());
+					if (found == class_positions.end())
+						class_positions.push_back(signature);
+				}
+
+				Bits256 start{};
+				start.set(0);
+				states = { Bits256{}, start };
+				state_keys = { Bits256{}.key(), start.key() };
+
+				for (std::size_t s = 0; s < states.size(); ++s)
+				{
+					Bits256 const current = states[s];
+
+					bool const accepts = (current & whole.last).any() || (current.test(0) && whole.nullable);
+					accepting.push_back(accepts);
+
+					// Every position that can follow the state, whatever the byte - each class keeps its own
+					Bits256 reachable{};
+					current.for_each([&](std::size_t p) { reachable |= automaton.follow[p]; });
+
+					for (Bits256 const& members : class_positions)
+					{
+						Bits256 const target = reachable & members;
+
+						std::uint64_t const key = target.key();
+						std::size_t found = 0;
+						while (found < states.size() && (state_keys[found] != key || !(states[found] == target)))
+							++found;
+
+						next.push_back(static_cast<std::uint16_t>(found));
+						if (found == states.size())
+						{
+							if (states.size() >= max_states)
+								compile_error("snct::Matches - pattern needs more than 4096 DFA states");
+							states.push_back(target);
+							state_keys.push_back(key);
+						}
+					}
+				}
+			}
+		};
+
+		struct Dfa_Size
+		{
+			std::size_t states;
+			std::size_t classes;
+		};
+
+		constexpr Dfa_Size dfa_size(std::string_view pattern)
+		{
+			Dfa_Builder const builder{ pattern };
+			return { builder.states.size(), builder.class_positions.size() };
+		}
+
+
+
+		template<std::size_t States, std::size_t Classes>
+		struct Dfa
+		{
+			std::array<std::uint16_t, 256> class_of{};
+			std::array<std::uint16_t, States * Classes> next{};
+			std::array<bool, States> accepting{};
+
+			[[nodiscard]] constexpr bool matches(std::string_view s) const noexcept
+			{
+				std::size_t state = 1;
+				for (char const c : s)
+				{
+					state = next[state * Classes + class_of[static_cast<unsigned char>(c)]];
+					if (state == 0)
+						return false;
+				}
+				return accepting[state];
+			}
+		};
+
+		template<Fixed_String pattern>
+		constexpr auto compile()
+		{
+			constexpr Dfa_Size size = dfa_size(pattern.view());
+
+			Dfa_Builder const builder{ pattern.view() };
+			Dfa<size.states, size.classes> dfa{};
+			dfa.class_of = builder.class_of;
+			std::copy(builder.next.begin(), builder.next.end(), dfa.next.begin());
+			std::copy(builder.accepting.begin(), builder.accepting.end(), dfa.accepting.begin());
+			return dfa;
+		}
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,213 @@
+#ifndef SNCT_SET_LOOKUP_HPP
+#define SNCT_SET_LOOKUP_HPP
+
+
+/***************************************************************************************************/
+/* Membership tests for a set of values known at compile time, used by snct::OneOf                  */
+/***************************************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace snct
+{
+	enum class OneOf_Strategy
+	{
+		linear,         // up to 8 values - compare against all of them, branch-free
+		bitset,         // integers spanning a small range - one bit per value in the range
+		perfect_hash,   // up to 32 integers - a collision free multiplicative hash, one compare
+		binary_search,  // everything else - a branch-free lower bound over the sorted values
+	};
+
+
+
+	namespace detail
+	{
+		inline constexpr std::size_t linear_set_limit = 8;
+		inline constexpr std::size_t hashed_set_limit = 32;
+		inline constexpr std::uint64_t max_bitset_range = 4096;
+		inline constexpr int hash_attempts = 256;
+
+		template<std::integral T>
+		constexpr std::uint64_t as_hash_key(T t) noexcept
+		{
+			return static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<T>>(t));
+		}
+
+		// t - lowest, computed without signed overflow
+		template<std::integral T>
+		constexpr std::uint64_t offset_from(T t, T lowest) noexcept
+		{
+			return static_cast<std::make_unsigned_t<T>>(as_hash_key(t) - as_hash_key(lowest));
+		}
+
+		template<typename T, std::size_t N>
+		constexpr std::uint64_t set_range(std::array<T, N> const& values) noexcept
+		{
+			auto const [lo, hi] = std::minmax_element(values.begin(), values.end());
+			return offset_from(*hi, *lo);
+		}
+
+		constexpr std::uint64_t splitmix64(std::uint64_t& state) noexcept
+		{
+			std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		template<std::size_t N>
+		constexpr int hash_bits() noexcept
+		{
+			return std::bit_width(std::bit_ceil(N) * 8) - 1;
+		}
+
+		constexpr std::size_t hash_slot(std::uint64_t key, std::uint64_t multiplier, int bits) noexcept
+		{
+			return static_cast<std::size_t>((key * multiplier) >> (64 - bits));
+		}
+
+		// Returns an odd multiplier that sends every value to a distinct slot, or 0 if none was found
+		template<typename T, std::size_t N>
+		constexpr std::uint64_t find_hash_multiplier(std::array<T, N> const& values) noexcept
+		{
+			constexpr int bits = hash_bits<N>();
+			std::uint64_t state = 0;
+
+			for (int attempt = 0; attempt < hash_attempts; ++attempt)
+			{
+				std::uint64_t const multiplier = splitmix64(state) | 1u;
+				std::array<bool, (std::size_t{ 1 } << bits)> used{};
+				bool collision = false;
+
+				for (T const& v : values)
+				{
+					auto const slot = hash_slot(as_hash_key(v), multiplier, bits);
+					collision = collision || used[slot];
+					used[slot] = true;
+				}
+
+				if (!collision)
+					return multiplier;
+			}
+			return 0;
+		}
+
+
+
+		template<typename T, std::size_t N>
+		constexpr std::array<T, N> sorted(std::array<T, N> values) noexcept
+		{
+			std::sort(values.begin(), values.end());
+			return values;
+		}
+
+		template<typename T, std::size_t N>
+		constexpr OneOf_Strategy choose_strategy(std::array<T, N> const& values) noexcept
+		{
+			if (N <= linear_set_limit)
+				return OneOf_Strategy::linear;
+
+			if constexpr (std::integral<T> && !std::same_as<T, bool>)
+			{
+				auto const range = set_range(values);
+				if (range < max_bitset_range && range < 64 * N)
+					return OneOf_Strategy::bitset;
+
+				auto const in_order = sorted(values);
+				bool const distinct = std::adjacent_find(in_order.begin(), in_order.end()) == in_order.end();
+
+				if (distinct && N <= hashed_set_limit && find_hash_multiplier(values) != 0)
+					return OneOf_Strategy::perfect_hash;
+			}
+
+			return OneOf_Strategy::binary_search;
+		}
+
+
+
+		template<OneOf_Strategy strategy, auto first, decltype(first) ... rest>
+		struct Set_Lookup;
+
+		template<auto first, decltype(first) ... rest>
+		struct Set_Lookup<OneOf_Strategy::linear, first, rest...>
+		{
+			using T = decltype(first);
+			static constexpr bool contains(T const& t) noexcept { return ((t == first) | ... | (t == rest)); }
+		};
+
+		template<auto first, decltype(first) ... rest>
+		struct Set_Lookup<OneOf_Strategy::bitset, first, rest...>
+		{
+			using T = decltype(first);
+			static constexpr T lowest = std::min({ first, rest... });
+			static constexpr std::uint64_t range = set_range(std::array{ first, rest... });
+
+			static constexpr auto bits = [] {
+				std::array<std::uint64_t, range / 64 + 1> b{};
+				for (T const& v : { first, rest... })
+				{
+					auto const offset = offset_from(v, lowest);
+					b[offset / 64] |= std::uint64_t{ 1 } << (offset % 64);
+				}
+				return b;
+			}();
+
+			static constexpr bool contains(T const& t) noexcept
+			{
+				auto const key = offset_from(t, lowest);
+				return key <= range && ((bits[key / 64] >> (key % 64)) & 1u);
+			}
+		};
+
+		template<auto first, decltype(first) ... rest>
+		struct Set_Lookup<OneOf_Strategy::perfect_hash, first, rest...>
+		{
+			using T = decltype(first);
+			static constexpr std::size_t count = 1 + sizeof...(rest);
+			static constexpr int bits = hash_bits<count>();
+			static constexpr std::uint64_t multiplier = find_hash_multiplier(std::array{ first, rest... });
+
+			// Empty slots hold a value that hashes elsewhere, so a probe that lands in one never matches
+			static constexpr auto slots = [] {
+				std::array<T, (std::size_t{ 1 } << bits)> s{};
+				s.fill(first);
+				for (T const& v : { first, rest... })
+					s[hash_slot(as_hash_key(v), multiplier, bits)] = v;
+				return s;
+			}();
+
+			static constexpr bool contains(T const& t) noexcept
+			{
+				return slots[hash_slot(as_hash_key(t), multiplier, bits)] == t;
+			}
+		};
+
+		template<auto first, decltype(first) ... rest>
+		struct Set_Lookup<OneOf_Strategy::binary_search, first, rest...>
+		{
+			using T = decltype(first);
+			static constexpr auto values = sorted(std::array{ first, rest... });
+
+			static constexpr bool contains(T const& t) noexcept
+			{
+				T const* base = values.data();
+				std::size_t n = values.size();
+				while (n > 1)
+				{
+					std::size_t const half = n / 2;
+					base = (base[half - 1] < t) ? base + half : base;
+					n -= half;
+				}
+				return *base == t;
+			}
+		};
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,143 @@
+#ifndef SNCT_SORT_HPP
+#define SNCT_SORT_HPP
+
+
+/***************************************************************************************************/
+/* Sorting and counting constrained integers. The range allowed by the constraints is known at      */
+/* compile time, which sizes the histogram of a counting sort and the number of radix sort passes.  */
+/***************************************************************************************************/
+
+#include "snct_bounds.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace snct
+{
+	namespace detail
+	{
+		inline constexpr std::size_t small_sort_limit = 64;
+		inline constexpr std::uintmax_t counting_sort_limit = std::uintmax_t{ 1 } << 16;
+		inline constexpr std::uintmax_t histogram_limit = std::uintmax_t{ 1 } << 20;
+		inline constexpr int max_radix_bits = 11;
+
+
+
+		// As few passes as possible with at most 11 bits (2048 buckets) each, so every pass's histogram
+		// stays in L1
+		template<typename Alias>
+		struct Radix_Plan
+		{
+			static constexpr int key_bits = std::bit_width(Integer_Range<Alias>::max_key);
+			static constexpr int passes = (key_bits + max_radix_bits - 1) / max_radix_bits;
+			static constexpr int bits = passes == 0 ? 0 : (key_bits + passes - 1) / passes;
+		};
+
+
+
+		// Rewrites the values from their counts - equal values are indistinguishable, so nothing but
+		// the counts has to be kept
+		template<typename Alias>
+		void counting_sort(std::span<Alias> values)
+		{
+			using Range = Integer_Range<Alias>;
+
+			std::vector<std::size_t> counts(static_cast<std::size_t>(Range::size));
+			for (Alias const& v : values)
+				++counts[Range::key(v.get())];
+
+			auto out = values.begin();
+			for (std::size_t k = 0; k < counts.size(); ++k)
+				out = std::fill_n(out, counts[k], Trusted::make<Alias>(Range::value(static_cast<typename Range::Key>(k))));
+		}
+
+
+
+		// Least significant digit first, alternating between values and a scratch copy
+		template<typename Alias>
+		void radix_sort(std::span<Alias> values)
+		{
+			using Range = Integer_Range<Alias>;
+			constexpr int bits = Radix_Plan<Alias>::bits;
+			constexpr std::size_t buckets = std::size_t{ 1 } << bits;
+			constexpr auto mask = static_cast<typename Range::Key>(buckets - 1);
+
+			std::vector<Alias> scratch(values.begin(), values.end());
+			std::span<Alias> from = values;
+			std::span<Alias> to = scratch;
+
+			for (int pass = 0; pass < Radix_Plan<Alias>::passes; ++pass)
+			{
+				int const shift = pass * bits;
+				auto const digit = [&](Alias const& v) { return static_cast<std::size_t>((Range::key(v.get()) >> shift) & mask); };
+
+				std::array<std::size_t, buckets> offsets{};
+				for (Alias const& v : from)
+					++offsets[digit(v)];
+
+				std::size_t sum = 0;
+				for (auto& offset : offsets)
+					sum += std::exchange(offset, sum);
+
+				for (Alias const& v : from)
+					to[offsets[digit(v)]++] = v;
+
+				std::swap(from, to);
+			}
+
+			if (from.data() != values.data())
+				std::copy(from.begin(), from.end(), values.begin());
+		}
+	}
+
+
+
+	// Sorts constrained integers in ascending order. Depending on how many values there are and how
+	// many the constraints allow, this is a counting sort, a radix sort with as few passes as the
+	// range allows, or std::sort for short inputs.
+	template<std::ranges::contiguous_range R>
+		requires detail::Constrained_Integer<std::ranges::range_value_t<R>> && std::ranges::output_range<R, std::ranges::range_value_t<R>>
+	void sort(R&& range)
+	{
+		using Alias = std::ranges::range_value_t<R>;
+		using Range = detail::Integer_Range<Alias>;
+		auto const values = std::span<Alias>{ std::ranges::data(range), std::ranges::size(range) };
+
+		if (values.size() < detail::small_sort_limit)
+			std::sort(values.begin(), values.end(), [](Alias const& a, Alias const& b) { return a.get() < b.get(); });
+		else if (Range::size != 0 && Range::size <= detail::counting_sort_limit && Range::size <= values.size() * 2 * detail::Radix_Plan<Alias>::passes)
+			detail::counting_sort(values);
+		else
+			detail::radix_sort(values);
+	}
+
+
+
+	// How many times each allowed value occurs: counts[v - lowest], where lowest is the smallest
+	// value the constraints allow. Only for ranges of up to 2^20 values.
+	template<std::ranges::input_range R>
+		requires detail::Constrained_Integer<std::ranges::range_value_t<R>>
+	[[nodiscard]] std::vector<std::size_t> histogram(R const& range)
+	{
+		using Range = detail::Integer_Range<std::ranges::range_value_t<R>>;
+		static_assert(Range::size != 0 && Range::size <= detail::histogram_limit,
+			"snct::histogram: the constraints allow too many values for a direct-indexed histogram");
+
+		std::vector<std::size_t> counts(static_cast<std::size_t>(Range::size));
+		for (auto const& v : range)
+			++counts[Range::key(v.get())];
+		return counts;
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,68 @@
+#ifndef SNCT_STRING_CONSTRAINTS_HPP
+#define SNCT_STRING_CONSTRAINTS_HPP
+
+#include "snct_constraints.hpp"
+#include "snct_regex.hpp"
+#include "snct_text_kernels.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+namespace snct
+{
+	// The cost hints (see Costed_Constraint) reflect that these walk the whole string, so cheap
+	// checks like MaxLength go first. ValidUtf8, Ascii and NoControlChars only check the new bytes
+	// after an append (see Appending_Constraint) - a valid UTF-8 string ends on a character boundary.
+
+	struct ValidUtf8
+	{
+		constexpr static bool is_satisfied(std::string_view t) noexcept { return detail::text::is_valid_utf8(t); }
+		inline static const char* error_message() noexcept { return "Constraint 'snct::ValidUtf8' was violated"; }
+		static constexpr double cost = 4;
+		constexpr static bool is_satisfied_after_append(std::string_view t, std::size_t old_size) noexcept { return is_satisfied(t.substr(std::min(old_size, t.size()))); }
+	};
+
+
+	struct Ascii
+	{
+		constexpr static bool is_satisfied(std::string_view t) noexcept { return detail::text::ascii_prefix(t) == t.size(); }
+		inline static const char* error_message() noexcept { return "Constraint 'snct::Ascii' was violated"; }
+		static constexpr double cost = 2;
+		constexpr static bool is_satisfied_after_append(std::string_view t, std::size_t old_size) noexcept { return is_satisfied(t.substr(std::min(old_size, t.size()))); }
+	};
+
+
+	// Satisfied if there are no ASCII control characters (0x00-0x1F and 0x7F), including
+	// tabs and line breaks
+	struct NoControlChars
+	{
+		constexpr static bool is_satisfied(std::string_view t) noexcept { return !detail::text::has_control(t); }
+		inline static const char* error_message() noexcept { return "Constraint 'snct::NoControlChars' was violated"; }
+		static constexpr double cost = 2;
+		constexpr static bool is_satisfied_after_append(std::string_view t, std::size_t old_size) noexcept { return is_satisfied(t.substr(std::min(old_size, t.size()))); }
+	};
+
+
+	// Satisfied if the whole string matches the pattern - see snct_regex.hpp for the supported syntax.
+	// The pattern is compiled to a DFA at compile time, so matching is one table lookup per byte.
+	template<Fixed_String pattern>
+	struct Matches
+	{
+		static constexpr auto dfa = detail::regex::compile<pattern>();
+		constexpr static bool is_satisfied(std::string_view t) noexcept { return dfa.matches(t); }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::Matches", pattern>.data(); }
+		static constexpr double cost = 16;
+	};
+
+
+	// Length in bytes, not in characters
+	template<std::size_t length>
+	struct MaxLength
+	{
+		constexpr static bool is_satisfied(std::string_view t) noexcept { return t.size() <= length; }
+		inline static const char* error_message() noexcept { return detail::violation_message<"snct::MaxLength", length>.data(); }
+	};
+}
+
+#endif //header guard
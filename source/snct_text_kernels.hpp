@@ -0,0 +1,230 @@
+#ifndef SNCT_TEXT_KERNELS_HPP
+#define SNCT_TEXT_KERNELS_HPP
+
+
+/***************************************************************************************************/
+/* Byte scanning for the string constraints. Each kernel has a constexpr scalar version, and x86-64 */
+/* builds pick an SSE2 or AVX2 version at runtime depending on what the CPU supports                */
+/***************************************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SNCT_TEXT_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SNCT_TEXT_TARGET_AVX2
+#else
+#define SNCT_TEXT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace snct::detail::text
+{
+	// SCALAR
+
+	constexpr bool is_control(unsigned char c) noexcept
+	{
+		return c < 0x20 || c == 0x7F;
+	}
+
+	constexpr std::size_t ascii_prefix_scalar(std::string_view s, std::size_t from = 0) noexcept
+	{
+		std::size_t i = from;
+		while (i < s.size() && static_cast<unsigned char>(s[i]) < 0x80)
+			++i;
+		return i;
+	}
+
+	constexpr bool has_control_scalar(std::string_view s, std::size_t from = 0) noexcept
+	{
+		for (std::size_t i = from; i < s.size(); ++i)
+			if (is_control(static_cast<unsigned char>(s[i])))
+				return true;
+		return false;
+	}
+
+	// Length of the well-formed UTF-8 sequence starting at s[i] (Unicode table 3-7), or 0 if the
+	// sequence is ill-formed, truncated, overlong or encodes a surrogate.
+	constexpr std::size_t utf8_sequence_length(std::string_view s, std::size_t i) noexcept
+	{
+		auto const byte = [&](std::size_t k) { return static_cast<unsigned char>(s[i + k]); };
+		auto const continuation = [&](std::size_t k, unsigned char lo = 0x80, unsigned char hi = 0xBF) {
+			return i + k < s.size() && lo <= byte(k) && byte(k) <= hi;
+		};
+
+		unsigned char const lead = byte(0);
+
+		if (lead < 0x80) return 1;
+		if (lead < 0xC2) return 0;
+		if (lead < 0xE0) return continuation(1) ? 2 : 0;
+		if (lead == 0xE0) return continuation(1, 0xA0) && continuation(2) ? 3 : 0;
+		if (lead == 0xED) return continuation(1, 0x80, 0x9F) && continuation(2) ? 3 : 0;
+		if (lead < 0xF0) return continuation(1) && continuation(2) ? 3 : 0;
+		if (lead == 0xF0) return continuation(1, 0x90) && continuation(2) && continuation(3) ? 4 : 0;
+		if (lead < 0xF4) return continuation(1) && continuation(2) && continuation(3) ? 4 : 0;
+		if (lead == 0xF4) return continuation(1, 0x80, 0x8F) && continuation(2) && continuation(3) ? 4 : 0;
+		return 0;
+	}
+
+
+
+	// VECTOR
+
+	// Every kernel below returns the same as its scalar counterpart. They handle whole blocks and
+	// leave the tail to the scalar version.
+
+	inline std::size_t ascii_prefix_swar(std::string_view s) noexcept
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= s.size(); i += 8)
+		{
+			std::uint64_t block;
+			std::memcpy(&block, s.data() + i, 8);
+			if (block & 0x8080808080808080ull)
+				break;
+		}
+		return ascii_prefix_scalar(s, i);
+	}
+
+#if defined(SNCT_TEXT_X86_64)
+	inline std::size_t ascii_prefix_sse2(std::string_view s) noexcept
+	{
+		std::size_t i = 0;
+		for (; i + 16 <= s.size(); i += 16)
+		{
+			__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s.data() + i));
+			if (_mm_movemask_epi8(block) != 0)
+				break;
+		}
+		return ascii_prefix_scalar(s, i);
+	}
+
+	inline bool has_control_sse2(std::string_view s) noexcept
+	{
+		__m128i const below_space = _mm_set1_epi8(0x1F);
+		__m128i const del = _mm_set1_epi8(0x7F);
+
+		std::size_t i = 0;
+		for (; i + 16 <= s.size(); i += 16)
+		{
+			__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s.data() + i));
+			__m128i const control = _mm_or_si128(
+				_mm_cmpeq_epi8(_mm_min_epu8(block, below_space), block),
+				_mm_cmpeq_epi8(block, del));
+			if (_mm_movemask_epi8(control) != 0)
+				return true;
+		}
+		return has_control_scalar(s, i);
+	}
+
+	SNCT_TEXT_TARGET_AVX2 inline std::size_t ascii_prefix_avx2(std::string_view s) noexcept
+	{
+		std::size_t i = 0;
+		for (; i + 32 <= s.size(); i += 32)
+		{
+			__m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s.data() + i));
+			if (_mm256_movemask_epi8(block) != 0)
+				break;
+		}
+		return ascii_prefix_scalar(s, i);
+	}
+
+	SNCT_TEXT_TARGET_AVX2 inline bool has_control_avx2(std::string_view s) noexcept
+	{
+		__m256i const below_space = _mm256_set1_epi8(0x1F);
+		__m256i const del = _mm256_set1_epi8(0x7F);
+
+		std::size_t i = 0;
+		for (; i + 32 <= s.size(); i += 32)
+		{
+			__m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s.data() + i));
+			__m256i const control = _mm256_or_si256(
+				_mm256_cmpeq_epi8(_mm256_min_epu8(block, below_space), block),
+				_mm256_cmpeq_epi8(block, del));
+			if (_mm256_movemask_epi8(control) != 0)
+				return true;
+		}
+		return has_control_scalar(s, i);
+	}
+
+	inline bool cpu_has_avx2() noexcept
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		__cpuid(info, 1);
+		bool const os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+
+		__cpuidex(info, 7, 0);
+		return os_saves_ymm && (info[1] & (1 << 5));
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	// Read before it is initialized (from another static initializer), this is false - which is
+	// still a correct choice
+	inline bool const use_avx2 = cpu_has_avx2();
+#endif
+
+
+
+	// DISPATCH
+
+	constexpr std::size_t ascii_prefix(std::string_view s) noexcept
+	{
+		if (std::is_constant_evaluated())
+			return ascii_prefix_scalar(s);
+
+#if defined(SNCT_TEXT_X86_64)
+		return use_avx2 ? ascii_prefix_avx2(s) : ascii_prefix_sse2(s);
+#else
+		return ascii_prefix_swar(s);
+#endif
+	}
+
+	constexpr bool has_control(std::string_view s) noexcept
+	{
+		if (std::is_constant_evaluated())
+			return has_control_scalar(s);
+
+#if defined(SNCT_TEXT_X86_64)
+		return use_avx2 ? has_control_avx2(s) : has_control_sse2(s);
+#else
+		return has_control_scalar(s);
+#endif
+	}
+
+	// Runs of ASCII are skipped a vector at a time, other sequences are checked one at a time
+	constexpr bool is_valid_utf8(std::string_view s) noexcept
+	{
+		std::size_t i = 0;
+		while (i < s.size())
+		{
+			i += ascii_prefix(s.substr(i));
+			if (i == s.size())
+				return true;
+
+			std::size_t const length = utf8_sequence_length(s, i);
+			if (length == 0)
+				return false;
+			i += length;
+		}
+		return true;
+	}
+
+} //namespace
+
+#undef SNCT_TEXT_TARGET_AVX2
+#undef SNCT_TEXT_X86_64
+
+#endif //header guard
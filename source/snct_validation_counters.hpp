@@ -0,0 +1,325 @@
+#ifndef SNCT_VALIDATION_COUNTERS_HPP
+#define SNCT_VALIDATION_COUNTERS_HPP
+
+
+/***************************************************************************************************/
+/* Opt-in counts of how often each constraint of each Constrained alias is evaluated and how often  */
+/* it fails. Enable with SNCT_VALIDATION_COUNTERS (see snct::counts_validations) and include this   */
+/* header in at least one translation unit.                                                        */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <vector>
+
+namespace snct
+{
+	struct Validation_Count
+	{
+		std::type_info const* alias;       // the Constrained type
+		std::type_info const* constraint;
+		const char* error_message;         // the constraint's error_message(), to tell constraints apart
+		std::uint64_t evaluations = 0;
+		std::uint64_t failures = 0;
+	};
+
+
+
+	namespace detail::counters
+	{
+		// Counters are allocated per thread, in chunks, as (alias, constraint) pairs are first seen.
+		// Pairs beyond max_ids are not counted.
+		inline constexpr std::size_t chunk_size = 64;
+		inline constexpr std::size_t max_chunks = 64;
+		inline constexpr std::size_t max_ids = chunk_size * max_chunks;
+
+		// Only the owning thread writes a cell, so increments are a relaxed load and store rather than
+		// a locked read-modify-write. Each cell has its own cache line.
+		struct alignas(64) Cell
+		{
+			std::atomic<std::uint64_t> evaluations{ 0 };
+			std::atomic<std::uint64_t> failures{ 0 };
+		};
+
+		inline void increment(std::atomic<std::uint64_t>& counter) noexcept
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		struct Chunk
+		{
+			std::array<Cell, chunk_size> cells;
+		};
+
+		class Thread_Counters
+		{
+		public:
+			Thread_Counters() = default;
+			Thread_Counters(Thread_Counters const&) = delete;
+			Thread_Counters& operator=(Thread_Counters const&) = delete;
+			~Thread_Counters();
+
+			// nullptr if id is beyond the last chunk, or the chunk could not be allocated
+			Cell* cell(std::size_t id) noexcept;
+
+			// Safe to call from any thread while the owner is counting
+			std::uint64_t evaluations(std::size_t id) const noexcept;
+			std::uint64_t failures(std::size_t id) const noexcept;
+
+			// The registry's list of live threads runs through the threads themselves
+			Thread_Counters* previous_live = nullptr;
+			Thread_Counters* next_live = nullptr;
+
+		private:
+			Cell const* find(std::size_t id) const noexcept;
+			std::array<std::atomic<Chunk*>, max_chunks> chunks_{};
+		};
+
+
+
+		// Guards the short sections that add and remove threads. Unlike std::mutex it cannot throw.
+		class Spin_Lock
+		{
+		public:
+			void lock() noexcept
+			{
+				while (flag_.test_and_set(std::memory_order_acquire))
+					flag_.wait(true, std::memory_order_relaxed);
+			}
+
+			void unlock() noexcept
+			{
+				flag_.clear(std::memory_order_release);
+				flag_.notify_one();
+			}
+
+		private:
+			std::atomic_flag flag_;
+		};
+
+		// The names of an id, and the counts of the threads that have finished
+		struct Id_Entry
+		{
+			std::atomic<std::type_info const*> alias{ nullptr };
+			std::atomic<std::type_info const*> constraint{ nullptr };
+			std::atomic<const char*> error_message{ nullptr };
+			std::atomic<bool> named{ false };
+			std::uint64_t retired_evaluations = 0;  // guarded by the registry's lock
+			std::uint64_t retired_failures = 0;
+		};
+
+		// Everything validation touches is fixed in size, so registering a pair or a thread never
+		// allocates - only snapshot does
+		class Registry
+		{
+		public:
+			// max_ids once every id is taken
+			std::size_t add(std::type_info const& alias, std::type_info const& constraint, const char* error_message) noexcept;
+
+			void attach(Thread_Counters* thread) noexcept;
+			// Keeps the thread's counts, so they outlive the thread
+			void detach(Thread_Counters* thread) noexcept;
+
+			[[nodiscard]] std::vector<Validation_Count> snapshot();
+
+		private:
+			std::size_t ids() const noexcept;
+
+			std::array<Id_Entry, max_ids> ids_{};
+			std::atomic<std::size_t> next_id_{ 0 };
+			Spin_Lock lock_;
+			Thread_Counters* live_ = nullptr;
+		};
+
+		inline Registry& registry()
+		{
+			static Registry r;
+			return r;
+		}
+
+
+
+		// Registers with the registry on a thread's first count, and hands the counts over when the thread ends
+		class Thread_Handle
+		{
+		public:
+			Thread_Handle() noexcept { registry().attach(&counters); }
+			~Thread_Handle() { registry().detach(&counters); }
+			Thread_Counters counters;
+		};
+
+		inline Thread_Counters& this_thread()
+		{
+			thread_local Thread_Handle handle;
+			return handle.counters;
+		}
+
+		template<typename Alias, typename ConstraintType>
+		std::size_t id() noexcept
+		{
+			static std::size_t const i = registry().add(typeid(Alias), typeid(ConstraintType), ConstraintType::error_message());
+			return i;
+		}
+	}
+
+
+
+	// The counts for every (alias, constraint) pair that has been evaluated so far, summed over all
+	// threads - including threads that have finished
+	[[nodiscard]] inline std::vector<Validation_Count> validation_counters()
+	{
+		return detail::counters::registry().snapshot();
+	}
+
+
+
+	template<typename Alias, typename ConstraintType>
+	void detail::count_validation(bool satisfied) noexcept
+	{
+		auto* const cell = counters::this_thread().cell(counters::id<Alias, ConstraintType>());
+		if (cell == nullptr)
+			return;
+
+		counters::increment(cell->evaluations);
+		if (!satisfied)
+			counters::increment(cell->failures);
+	}
+
+
+
+	namespace detail::counters
+	{
+		inline Thread_Counters::~Thread_Counters()
+		{
+			for (auto& chunk : chunks_)
+				delete chunk.load(std::memory_order_relaxed);
+		}
+
+
+
+		inline Cell* Thread_Counters::cell(std::size_t id) noexcept
+		{
+			if (id >= chunk_size * max_chunks)
+				return nullptr;
+
+			auto& slot = chunks_[id / chunk_size];
+			Chunk* chunk = slot.load(std::memory_order_relaxed);
+			if (chunk == nullptr)
+			{
+				chunk = new (std::nothrow) Chunk{};
+				if (chunk == nullptr)
+					return nullptr;
+				slot.store(chunk, std::memory_order_release);
+			}
+			return &chunk->cells[id % chunk_size];
+		}
+
+
+
+		inline Cell const* Thread_Counters::find(std::size_t id) const noexcept
+		{
+			if (id >= chunk_size * max_chunks)
+				return nullptr;
+			Chunk const* chunk = chunks_[id / chunk_size].load(std::memory_order_acquire);
+			return chunk == nullptr ? nullptr : &chunk->cells[id % chunk_size];
+		}
+
+		inline std::uint64_t Thread_Counters::evaluations(std::size_t id) const noexcept
+		{
+			auto const* c = find(id);
+			return c == nullptr ? 0 : c->evaluations.load(std::memory_order_relaxed);
+		}
+
+		inline std::uint64_t Thread_Counters::failures(std::size_t id) const noexcept
+		{
+			auto const* c = find(id);
+			return c == nullptr ? 0 : c->failures.load(std::memory_order_relaxed);
+		}
+
+
+
+		inline std::size_t Registry::add(std::type_info const& alias, std::type_info const& constraint, const char* error_message) noexcept
+		{
+			std::size_t const id = next_id_.fetch_add(1, std::memory_order_relaxed);
+			if (id >= max_ids)
+				return max_ids;
+
+			Id_Entry& entry = ids_[id];
+			entry.alias.store(&alias, std::memory_order_relaxed);
+			entry.constraint.store(&constraint, std::memory_order_relaxed);
+			entry.error_message.store(error_message, std::memory_order_relaxed);
+			entry.named.store(true, std::memory_order_release);
+			return id;
+		}
+
+		inline std::size_t Registry::ids() const noexcept
+		{
+			std::size_t const n = next_id_.load(std::memory_order_relaxed);
+			return n < max_ids ? n : max_ids;
+		}
+
+		inline void Registry::attach(Thread_Counters* thread) noexcept
+		{
+			auto const lock = std::scoped_lock{ lock_ };
+			thread->next_live = live_;
+			if (live_ != nullptr)
+				live_->previous_live = thread;
+			live_ = thread;
+		}
+
+		inline void Registry::detach(Thread_Counters* thread) noexcept
+		{
+			auto const lock = std::scoped_lock{ lock_ };
+			for (std::size_t id = 0, n = ids(); id < n; ++id)
+			{
+				ids_[id].retired_evaluations += thread->evaluations(id);
+				ids_[id].retired_failures += thread->failures(id);
+			}
+
+			if (thread->previous_live != nullptr)
+				thread->previous_live->next_live = thread->next_live;
+			else
+				live_ = thread->next_live;
+			if (thread->next_live != nullptr)
+				thread->next_live->previous_live = thread->previous_live;
+		}
+
+		inline std::vector<Validation_Count> Registry::snapshot()
+		{
+			std::vector<Validation_Count> counts;
+			counts.reserve(ids());
+
+			auto const lock = std::scoped_lock{ lock_ };
+			for (std::size_t id = 0, n = ids(); id < n; ++id)
+			{
+				Id_Entry const& entry = ids_[id];
+				if (!entry.named.load(std::memory_order_acquire))
+					continue;  // still being added
+
+				auto count = Validation_Count{
+					entry.alias.load(std::memory_order_relaxed),
+					entry.constraint.load(std::memory_order_relaxed),
+					entry.error_message.load(std::memory_order_relaxed),
+					entry.retired_evaluations,
+					entry.retired_failures };
+
+				for (Thread_Counters const* thread = live_; thread != nullptr; thread = thread->next_live)
+				{
+					count.evaluations += thread->evaluations(id);
+					count.failures += thread->failures(id);
+				}
+				counts.push_back(count);
+			}
+			return counts;
+		}
+	}
+
+} //namespace
+#endif //header guard
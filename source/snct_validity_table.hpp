@@ -0,0 +1,92 @@
+#ifndef SNCT_VALIDITY_TABLE_HPP
+#define SNCT_VALIDITY_TABLE_HPP
+
+
+/***************************************************************************************************/
+/* For 8 and 16 bit integers, every possible value can be checked ahead of time and stored as a bit */
+/***************************************************************************************************/
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace snct
+{
+	namespace detail
+	{
+		template<typename ConstraintType, typename ValueType>
+		concept Constexpr_Constraint = requires
+		{
+			typename std::bool_constant<(ConstraintType::is_satisfied(ValueType{}), true)>;
+		};
+	}
+
+
+
+	// The constraints on an 8 or 16 bit integer can be tabulated if every constraint can be evaluated
+	// at compile time. (Only checked for one value - a constraint that is constexpr for some values
+	// but not others will fail to compile rather than fall back)
+	template<typename ValueType, typename ... ConstraintTypes>
+	concept Tabulatable =
+		std::integral<ValueType> &&
+		!std::same_as<ValueType, bool> &&
+		sizeof(ValueType) <= 2 &&
+		(detail::Constexpr_Constraint<ConstraintTypes, ValueType> && ...);
+
+
+
+	template<typename ValueType, typename ... ConstraintTypes>
+		requires Tabulatable<ValueType, ConstraintTypes...>
+	class Validity_Table
+	{
+	public:
+		using Index = std::make_unsigned_t<ValueType>;
+		static constexpr std::size_t size = std::size_t{ 1 } << (8 * sizeof(ValueType));
+
+		constexpr Validity_Table() noexcept
+		{
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				auto const value = static_cast<ValueType>(static_cast<Index>(i));
+				bool const valid = ((ConstraintTypes::is_satisfied(value) ? true : false) && ...);
+				bits_[i / 64] |= std::uint64_t{ valid } << (i % 64);
+			}
+		}
+
+		[[nodiscard]] constexpr bool test(ValueType value) const noexcept
+		{
+			auto const i = static_cast<std::size_t>(static_cast<Index>(value));
+			return (bits_[i / 64] >> (i % 64)) & 1u;
+		}
+
+	private:
+		std::array<std::uint64_t, size / 64 + (size % 64 != 0)> bits_{};
+	};
+
+
+
+	namespace detail
+	{
+		// 256 entries are cheap enough to build in any compiler's constant evaluator
+		template<typename ValueType, typename ... ConstraintTypes>
+		inline constexpr Validity_Table<ValueType, ConstraintTypes...> constexpr_validity_table{};
+
+		// 65536 entries can exceed default constexpr step limits (MSVC, clang). Constant initialization
+		// is still used where the compiler manages it, otherwise the table is built once at startup.
+		template<typename ValueType, typename ... ConstraintTypes>
+		inline const Validity_Table<ValueType, ConstraintTypes...> static_validity_table{};
+
+		template<typename ValueType, typename ... ConstraintTypes>
+		[[nodiscard]] constexpr auto const& validity_table() noexcept
+		{
+			if constexpr (sizeof(ValueType) == 1)
+				return constexpr_validity_table<ValueType, ConstraintTypes...>;
+			else
+				return static_validity_table<ValueType, ConstraintTypes...>;
+		}
+	}
+
+} //namespace
+#endif //header guard
@@ -0,0 +1,180 @@
+#ifndef SNCT_VIOLATION_HOOKS_HPP
+#define SNCT_VIOLATION_HOOKS_HPP
+
+
+/***************************************************************************************************/
+/* Opt-in callback for rejected values, sampled and rate limited so a flood of bad input cannot make */
+/* the callback the bottleneck. Enable with SNCT_VIOLATION_HOOKS (see snct::calls_violation_hooks)   */
+/* and include this header in at least one translation unit.                                        */
+/***************************************************************************************************/
+
+#include "snct_constrained.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <source_location>
+#include <typeinfo>
+
+namespace snct
+{
+	struct Violation
+	{
+		std::type_info const* alias;    // the Constrained type
+		const char* error_message;      // from the constraint that rejected the value
+		std::source_location location;  // where the value was passed to the constructor or factory
+	};
+
+	// Called on the thread that constructed the rejected value, before the exception is thrown
+	using Violation_Hook = void (*)(Violation const&) noexcept;
+
+	// Passed to set_violation_hook as a template argument, so limits out of range - including NaN -
+	// do not compile
+	struct Violation_Hook_Limits
+	{
+		double sample_ratio = 1.0;        // the share of violations considered at all, from 0 to 1
+		double per_second = 100.0;        // sampled violations passed on per second, once the burst is used up - 0 for none
+		std::uint32_t burst = 100;        // sampled violations passed on in a row before per_second applies - at least 1
+	};
+
+
+
+	namespace detail::violation_hooks
+	{
+		// The rate limit is a token bucket, kept as the generic cell rate algorithm: a single timestamp
+		// that each call moves forward by interval, and calls are let through while it is less than
+		// burst * interval ahead of now. One compare-and-swap per sampled violation, no lock.
+		class Limiter
+		{
+		public:
+			// burst is at least 1
+		void configure(double per_second, std::uint32_t burst) noexcept;
+			bool try_acquire(std::int64_t now) noexcept;
+
+		private:
+			std::atomic<std::int64_t> interval_{ 0 };   // nanoseconds per token
+			std::atomic<std::int64_t> tolerance_{ 0 };  // how far ahead of now the timestamp may run
+			std::atomic<std::int64_t> theoretical_arrival_{ 0 };
+		};
+
+		struct State
+		{
+			std::atomic<Violation_Hook> hook{ nullptr };
+			std::atomic<std::uint64_t> sample_threshold{ 0 };  // sampled if a random 64 bit value is below this
+			std::atomic<bool> sample_all{ true };
+			Limiter limiter;
+		};
+
+		inline State& state()
+		{
+			static State s;
+			return s;
+		}
+
+		// xorshift64*, one generator per thread so sampling needs no shared state
+		inline std::uint64_t next_random() noexcept
+		{
+			thread_local std::uint64_t x = reinterpret_cast<std::uintptr_t>(&x) | 1;
+			x ^= x >> 12;
+			x ^= x << 25;
+			x ^= x >> 27;
+			return x * 0x2545F4914F6CDD1Dull;
+		}
+
+		inline std::int64_t now() noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+	}
+
+
+
+	// Replaces the hook and its limits, and refills the token bucket. Passing nullptr removes the hook,
+	// after which a rejected value costs one atomic load.
+	//
+	//     snct::set_violation_hook<snct::Violation_Hook_Limits{ .sample_ratio = 0.1, .burst = 10 }>(hook);
+	template<Violation_Hook_Limits limits = Violation_Hook_Limits{}>
+	void set_violation_hook(Violation_Hook hook) noexcept
+	{
+		// Written so that NaN fails every check
+		static_assert(limits.sample_ratio >= 0 && limits.sample_ratio <= 1, "snct::set_violation_hook: sample_ratio must be between 0 and 1");
+		static_assert(limits.per_second >= 0, "snct::set_violation_hook: per_second must not be negative or NaN");
+		static_assert(limits.burst >= 1, "snct::set_violation_hook: burst must be at least 1, or no violation would ever pass");
+
+		constexpr bool sample_all = limits.sample_ratio == 1;
+		constexpr std::uint64_t sample_threshold = sample_all ? 0 : static_cast<std::uint64_t>(limits.sample_ratio * 18446744073709551616.0);
+
+		auto& s = detail::violation_hooks::state();
+		s.hook.store(nullptr, std::memory_order_relaxed);
+		s.sample_all.store(sample_all, std::memory_order_relaxed);
+		s.sample_threshold.store(sample_threshold, std::memory_order_relaxed);
+		s.limiter.configure(limits.per_second, limits.burst);
+		s.hook.store(hook, std::memory_order_release);
+	}
+
+	[[nodiscard]] inline Violation_Hook violation_hook() noexcept
+	{
+		return detail::violation_hooks::state().hook.load(std::memory_order_acquire);
+	}
+
+
+
+	template<typename Alias>
+	void detail::call_violation_hook(const char* error_message, std::source_location const& location) noexcept
+	{
+		auto& s = violation_hooks::state();
+		Violation_Hook const hook = s.hook.load(std::memory_order_acquire);
+		if (hook == nullptr)
+			return;
+
+		if (!s.sample_all.load(std::memory_order_relaxed) && violation_hooks::next_random() >= s.sample_threshold.load(std::memory_order_relaxed))
+			return;
+
+		if (!s.limiter.try_acquire(violation_hooks::now()))
+			return;
+
+		hook(Violation{ &typeid(Alias), error_message, location });
+	}
+
+
+
+	namespace detail::violation_hooks
+	{
+		inline void Limiter::configure(double per_second, std::uint32_t burst) noexcept
+		{
+			// With no refill a token takes "forever", divided so burst tokens still fit in the tolerance
+			constexpr std::int64_t forever = std::numeric_limits<std::int64_t>::max() / 4;
+			std::int64_t const tokens = burst;
+
+			std::int64_t interval = forever / tokens;
+			if (per_second > 0 && 1e9 / per_second < static_cast<double>(interval))
+				interval = static_cast<std::int64_t>(1e9 / per_second);
+
+			interval_.store(interval, std::memory_order_relaxed);
+			tolerance_.store(interval * (tokens - 1), std::memory_order_relaxed);
+			theoretical_arrival_.store(0, std::memory_order_relaxed);
+		}
+
+
+
+		inline bool Limiter::try_acquire(std::int64_t now) noexcept
+		{
+			std::int64_t const interval = interval_.load(std::memory_order_relaxed);
+			std::int64_t const tolerance = tolerance_.load(std::memory_order_relaxed);
+
+			std::int64_t arrival = theoretical_arrival_.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				if (arrival - now > tolerance)
+					return false;
+
+				std::int64_t const next = (arrival > now ? arrival : now) + interval;
+				if (theoretical_arrival_.compare_exchange_weak(arrival, next, std::memory_order_relaxed))
+					return true;
+			}
+		}
+	}
+
+} //namespace
+#endif //header guard